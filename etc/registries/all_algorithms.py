@@ -64,11 +64,13 @@ lzss_bidirectional_coders = [
 # Suffix Array
 sa = [
     AlgorithmConfig(name="DivSufSort", header="ds/providers/DivSufSort.hpp"),
+    AlgorithmConfig(name="SAIS", header="ds/providers/SAIS.hpp"),
 ]
 
 # Phi Array
 phi = [
     AlgorithmConfig(name="PhiFromSA", header="ds/providers/PhiFromSA.hpp"),
+    AlgorithmConfig(name="BlockedPhiFromSA", header="ds/providers/BlockedPhiFromSA.hpp"),
 ]
 
 # PLCP Array
@@ -89,6 +91,7 @@ lcp = lcp_uncompressed + [
 # Inverse Suffix Array
 isa = [
     AlgorithmConfig(name="ISAFromSA", header="ds/providers/ISAFromSA.hpp"),
+    AlgorithmConfig(name="BlockedISAFromSA", header="ds/providers/BlockedISAFromSA.hpp"),
     AlgorithmConfig(name="SparseISA", header="ds/providers/SparseISA.hpp", sub=[sa]),
 ]
 
@@ -172,6 +175,23 @@ if config_match("^#define JUDY_H_AVAILABLE 1"): # if the Judy trie is available
         AlgorithmConfig(name="lz_trie::JudyTrie", header="compressors/lz_trie/JudyTrie.hpp"),
 ]
 
+# Self-tuning LZ trie ("lz_trie=auto"), only supported by lz78 and lzw
+lz_trie_auto = lz_trie + [
+    AlgorithmConfig(name="lz_trie::AutoTrie", header="compressors/lz_trie/AutoTrie.hpp", sub=[
+        [AlgorithmConfig(name="lz_trie::TernaryTrie", header="compressors/lz_trie/TernaryTrie.hpp")],
+        [AlgorithmConfig(name="lz_trie::BinarySortedTrie", header="compressors/lz_trie/BinarySortedTrie.hpp")],
+        [AlgorithmConfig(name="lz_trie::HashTrie", header="compressors/lz_trie/HashTrie.hpp", sub=[
+            [AlgorithmConfig(name="MixHasher", header="util/Hash.hpp")],
+            [AlgorithmConfig(name="LinearProber", header="util/Hash.hpp")]])],
+        [AlgorithmConfig(name="lz_trie::HashTriePlus", header="compressors/lz_trie/HashTriePlus.hpp", sub=[
+            [AlgorithmConfig(name="MixHasher", header="util/Hash.hpp")]])],
+        [AlgorithmConfig(name="lz_trie::RollingTrie", header="compressors/lz_trie/RollingTrie.hpp", sub=[
+            [AlgorithmConfig(name="WordpackRollingHash", header="util/Hash.hpp")],
+            [AlgorithmConfig(name="LinearProber", header="util/Hash.hpp")],
+            [AlgorithmConfig(name="MixHasher", header="util/Hash.hpp")]])],
+    ]),
+]
+
 ##### lz78u #####
 
 # LZ78U factorization strategies ("comp")
@@ -217,6 +237,7 @@ ipd = [
 
 ipddyn = ipd + [
     AlgorithmConfig(name="esp::DynamicSizeIPD", header="compressors/esp/DynamicSizeIPD.hpp", sub=[ipd]),
+    AlgorithmConfig(name="esp::PackedHashIPD", header="compressors/esp/PackedHashIPD.hpp"),
 ]
 
 slp_d_coder_2 = [
@@ -284,19 +305,21 @@ tdc.compressors = [
     AlgorithmConfig(name="LCPCompressor", header="compressors/LCPCompressor.hpp", sub=[lzss_bidirectional_coders, lcpcomp_comp, textds_lcpcomp]),
     AlgorithmConfig(name="RunLengthEncoder", header="compressors/RunLengthEncoder.hpp"),
     AlgorithmConfig(name="LiteralEncoder", header="compressors/LiteralEncoder.hpp", sub=[all_coders]),
-    AlgorithmConfig(name="LZ78Compressor", header="compressors/LZ78Compressor.hpp", sub=[universal_coders, lz_trie]),
-    AlgorithmConfig(name="LZ78UCompressor", header="compressors/LZ78UCompressor.hpp", sub=[lz78u_comp, universal_coders]),
-    AlgorithmConfig(name="LZWCompressor", header="compressors/LZWCompressor.hpp", sub=[universal_coders, lz_trie]),
+    AlgorithmConfig(name="LZ78Compressor", header="compressors/LZ78Compressor.hpp", sub=[universal_coders, lz_trie_auto]),
+    AlgorithmConfig(name="LZ78UCompressor", header="compressors/LZ78UCompressor.hpp", sub=[lz78u_comp, universal_coders, textds_lcp]),
+    AlgorithmConfig(name="LZWCompressor", header="compressors/LZWCompressor.hpp", sub=[universal_coders, lz_trie_auto]),
     AlgorithmConfig(name="LZ78PointerJumpingCompressor", header="compressors/LZ78PointerJumpingCompressor.hpp", sub=[universal_coders, lz_trie]),
     AlgorithmConfig(name="LZWPointerJumpingCompressor", header="compressors/LZWPointerJumpingCompressor.hpp", sub=[universal_coders, lz_trie]),
     AlgorithmConfig(name="RePairCompressor", header="compressors/RePairCompressor.hpp", sub=[non_consuming_coders]),
     AlgorithmConfig(name="LZSSLCPCompressor", header="compressors/LZSSLCPCompressor.hpp", sub=[lzss_coders, textds_lcp]),
     AlgorithmConfig(name="LZSSSlidingWindowCompressor", header="compressors/LZSSSlidingWindowCompressor.hpp", sub=[lzss_streaming_coders]),
+    AlgorithmConfig(name="LZ77AproxCompressor", header="compressors/LZ77AproxCompressor.hpp", sub=[lzss_coders]),
     AlgorithmConfig(name="MTFCompressor", header="compressors/MTFCompressor.hpp"),
     AlgorithmConfig(name="NoopCompressor", header="compressors/NoopCompressor.hpp"),
     AlgorithmConfig(name="BWTCompressor", header="compressors/BWTCompressor.hpp", sub=[textds_sa]),
     AlgorithmConfig(name="ChainCompressor", header="compressors/ChainCompressor.hpp"),
     AlgorithmConfig(name="DividingCompressor", header="compressors/DividingCompressor.hpp", sub=[dividing_strat]),
+    AlgorithmConfig(name="AutoCompressor", header="compressors/AutoCompressor.hpp"),
     AlgorithmConfig(name="LongCommonStringCompressor", header="compressors/LongCommonStringCompressor.hpp", sub=[long_common_strat]),
     AlgorithmConfig(name="EspCompressor", header="compressors/EspCompressor.hpp", sub=[slp_coder, ipddyn]),
     AlgorithmConfig(name="lfs::LFSCompressor", header="compressors/lfs/LFSCompressor.hpp", sub=[lfs_strat, coding_strat]),
@@ -312,6 +335,7 @@ if config_match("^#define SDSL_FOUND 1"): # if SDSL is available
 
 ##### Export available decompressors #####
 tdc.decompressors = [
+    AlgorithmConfig(name="AutoDecompressor", header="decompressors/AutoDecompressor.hpp"),
     AlgorithmConfig(name="BWTDecompressor", header="decompressors/BWTDecompressor.hpp",),
     AlgorithmConfig(name="ChainDecompressor", header="decompressors/ChainDecompressor.hpp",),
     AlgorithmConfig(name="DividingDecompressor", header="decompressors/DividingDecompressor.hpp"),
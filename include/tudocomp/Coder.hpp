@@ -1,5 +1,7 @@
 #pragma once
 
+#include <iterator>
+
 #include <tudocomp/io.hpp>
 #include <tudocomp/Algorithm.hpp>
 
@@ -83,6 +85,45 @@ public:
         m_out->write_bit(v);
     }
 
+    /// \brief Encodes a sequence of arbitrary-range integer values.
+    ///
+    /// This is equivalent to encoding each value in `[begin, end)` using
+    /// \ref encode with the given range, but the bit width is computed only
+    /// once and the values are packed into whole words before they are
+    /// written to the output.
+    ///
+    /// Coders that override \ref encode for a range type have to override
+    /// this for the same range type as well.
+    ///
+    /// \tparam iter_t The input iterator type.
+    /// \param begin The first value to encode.
+    /// \param end The end of the values to encode.
+    /// \param r The range shared by all values.
+    template<typename iter_t>
+    inline void encode_many(iter_t begin, iter_t end, const Range& r) {
+        const size_t min = r.min();
+        const size_t bits = bits_for(r.max() - r.min());
+
+        BitPacker packer(*m_out);
+        for(; begin != end; ++begin) {
+            packer.write_int(size_t(*begin) - min, bits);
+        }
+    }
+
+    /// \brief Encodes a sequence of bits.
+    ///
+    /// \tparam iter_t The input iterator type.
+    /// \param begin The first value to encode.
+    /// \param end The end of the values to encode.
+    /// \param r Unused.
+    template<typename iter_t>
+    inline void encode_many(iter_t begin, iter_t end, const BitRange& r) {
+        BitPacker packer(*m_out);
+        for(; begin != end; ++begin) {
+            packer.write_bit(*begin);
+        }
+    }
+
     /// \brief Flush any output that may be held back in a buffer.
     ///
     /// This is used for destruction of the encoder as well as for context
@@ -156,6 +197,45 @@ public:
         return value_t(m_in->read_bit());
     }
 
+    /// \brief Decodes a sequence of arbitrary-range integer values.
+    ///
+    /// This is equivalent to decoding each value in `[begin, end)` using
+    /// \ref decode with the given range, but the bit width is computed only
+    /// once.
+    ///
+    /// Coders that override \ref decode for a range type have to override
+    /// this for the same range type as well.
+    ///
+    /// \tparam iter_t The output iterator type.
+    /// \param begin The position of the first decoded value.
+    /// \param end The end of the decoded values.
+    /// \param r The range shared by all values.
+    template<typename iter_t>
+    inline void decode_many(iter_t begin, iter_t end, const Range& r) {
+        using value_t = typename std::iterator_traits<iter_t>::value_type;
+
+        const value_t min = value_t(r.min());
+        const size_t bits = bits_for(r.max() - r.min());
+        for(; begin != end; ++begin) {
+            *begin = min + m_in->read_int<value_t>(bits);
+        }
+    }
+
+    /// \brief Decodes a sequence of bits.
+    ///
+    /// \tparam iter_t The output iterator type.
+    /// \param begin The position of the first decoded value.
+    /// \param end The end of the decoded values.
+    /// \param r Unused.
+    template<typename iter_t>
+    inline void decode_many(iter_t begin, iter_t end, const BitRange& r) {
+        using value_t = typename std::iterator_traits<iter_t>::value_type;
+
+        for(; begin != end; ++begin) {
+            *begin = value_t(m_in->read_bit());
+        }
+    }
+
     inline const std::shared_ptr<BitIStream>& stream() {
         return m_in;
     }
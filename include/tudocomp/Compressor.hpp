@@ -44,6 +44,19 @@ public:
     /// \param input The input.
     /// \param output The output.
     virtual void decompress(Input& input, Output& output) = 0;
+
+    /// \brief Decompress only a range of the original text.
+    ///
+    /// \see Decompressor::extract
+    virtual void extract(Input& input, Output& output,
+                         size_t offset, size_t length) {
+        std::vector<uint8_t> buffer;
+        {
+            Output tmp(buffer);
+            decompress(input, tmp);
+        }
+        Decompressor::write_range(buffer, output, offset, length);
+    }
 };
 
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <tudocomp/io.hpp>
 #include <tudocomp/Algorithm.hpp>
 
@@ -25,6 +28,40 @@ public:
     /// \param input The input.
     /// \param output The output.
     virtual void decompress(Input& input, Output& output) = 0;
+
+    /// \brief Decompress only a range of the original text.
+    ///
+    /// The default implementation decompresses the whole input and
+    /// writes the requested range afterwards. Decompressors that allow
+    /// random access to their encoding override this.
+    ///
+    /// \param input The input.
+    /// \param output The output.
+    /// \param offset The position of the first byte to extract.
+    /// \param length The amount of bytes to extract. The range is
+    ///               clamped to the end of the text.
+    virtual void extract(Input& input, Output& output,
+                         size_t offset, size_t length) {
+        std::vector<uint8_t> buffer;
+        {
+            Output tmp(buffer);
+            decompress(input, tmp);
+        }
+        write_range(buffer, output, offset, length);
+    }
+
+    /// \brief Writes the given range of a decompressed text to the output.
+    ///
+    /// Used by the default implementation of \ref extract.
+    inline static void write_range(const std::vector<uint8_t>& text,
+                                   Output& output,
+                                   size_t offset, size_t length) {
+        const size_t begin = std::min(offset, text.size());
+        const size_t end = begin + std::min(length, text.size() - begin);
+
+        auto os = output.as_stream();
+        os.write((const char*) text.data() + begin, end - begin);
+    }
 };
 
 }
@@ -65,6 +65,18 @@ public:
         auto i = m_index++;
         return Literal { uliteral_t(m_view[i]), i };
     }
+
+    /// \brief Yields the literals that have not been iterated yet as a view,
+    ///        and skips them in the stream.
+    ///
+    /// The literals in the view are located at consecutive positions,
+    /// starting at the position of the next literal.
+    /// \return The view of the remaining literals.
+    inline View take_view() {
+        View rest = m_view.substr(m_index);
+        m_index = m_view.size();
+        return rest;
+    }
 };
 
 }
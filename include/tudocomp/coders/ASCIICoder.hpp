@@ -50,6 +50,12 @@ public:
         inline void encode(value_t v, const BitRange&) {
             m_out->write_int(v ? '1' : '0');
         }
+
+        /// Encodes each value separately, see \ref tdc::Encoder::encode_many.
+        template<typename iter_t, typename range_t>
+        inline void encode_many(iter_t begin, iter_t end, const range_t& r) {
+            for(; begin != end; ++begin) encode(*begin, r);
+        }
     };
 
     /// \brief Decodes data from an ASCII character stream.
@@ -85,6 +91,13 @@ public:
             uint8_t b = m_in->read_int<uint8_t>();
             return (b != '0');
         }
+
+        /// Decodes each value separately, see \ref tdc::Decoder::decode_many.
+        template<typename iter_t, typename range_t>
+        inline void decode_many(iter_t begin, iter_t end, const range_t& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+            for(; begin != end; ++begin) *begin = decode<value_t>(r);
+        }
     };
 };
 
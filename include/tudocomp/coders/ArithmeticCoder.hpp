@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include <tudocomp/Coder.hpp>
+#include <tudocomp/util/Histogram.hpp>
 
 namespace tdc {
 
@@ -49,16 +50,8 @@ public:
 
         template<class literals_t>
         inline void compute_histogram(literals_t&& literals) {
-            m_num_literals = 0;
             m_c.resize(MAX_LITERAL+1, 0);
-
-            while(literals.has_next()) {
-                uliteral_t c = literals.next().c;
-                DCHECK_LE(c, MAX_LITERAL);
-                DCHECK_LT(m_c[c], INDEX_MAX);
-                ++m_c[c];
-                ++m_num_literals;
-            }
+            m_num_literals = count_literals(literals, m_c.data());
 
             CHECK_GT(m_num_literals, 0U) << "input is empty";
 
@@ -162,6 +155,12 @@ public:
                 while(!encode_next(STOP));
             }
         }
+
+        /// Encodes each value separately, see \ref tdc::Encoder::encode_many.
+        template<typename iter_t, typename range_t>
+        inline void encode_many(iter_t begin, iter_t end, const range_t& r) {
+            for(; begin != end; ++begin) encode(*begin, r);
+        }
     };
 
     /// \brief Decodes data from an Arithmetic character stream.
@@ -267,6 +266,13 @@ public:
 
             return value_t(m_decode_buffer[m_decoded++]);
         }
+
+        /// Decodes each value separately, see \ref tdc::Decoder::decode_many.
+        template<typename iter_t, typename range_t>
+        inline void decode_many(iter_t begin, iter_t end, const range_t& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+            for(; begin != end; ++begin) *begin = decode<value_t>(r);
+        }
     };
 };
 
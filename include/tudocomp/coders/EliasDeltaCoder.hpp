@@ -23,11 +23,22 @@ public:
     public:
         using tdc::Encoder::Encoder;
         using tdc::Encoder::encode;
+        using tdc::Encoder::encode_many;
 
         template<typename value_t>
         inline void encode(value_t v, const Range& r) {
             m_out->write_elias_delta(v - value_t(r.min()) + 1);
         }
+
+        template<typename iter_t>
+        inline void encode_many(iter_t begin, iter_t end, const Range& r) {
+            const size_t min = r.min();
+
+            BitPacker packer(*m_out);
+            for(; begin != end; ++begin) {
+                write_elias_delta<size_t>(packer.bit_sink(), size_t(*begin) - min + 1);
+            }
+        }
     };
 
     /// \brief Decodes data from a stream of Elias-Delta codes.
@@ -35,11 +46,22 @@ public:
     public:
         using tdc::Decoder::Decoder;
         using tdc::Decoder::decode;
+        using tdc::Decoder::decode_many;
 
         template<typename value_t>
         inline value_t decode(const Range& r) {
             return value_t(r.min()) + m_in->read_elias_delta<value_t>() - 1;
         }
+
+        template<typename iter_t>
+        inline void decode_many(iter_t begin, iter_t end, const Range& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+
+            const value_t min = value_t(r.min());
+            for(; begin != end; ++begin) {
+                *begin = min + m_in->read_elias_delta<value_t>() - 1;
+            }
+        }
     };
 };
 
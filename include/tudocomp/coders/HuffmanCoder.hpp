@@ -7,6 +7,7 @@
 #include <tudocomp/util.hpp>
 #include <tudocomp/Range.hpp>
 #include <tudocomp/def.hpp>
+#include <tudocomp/util/Histogram.hpp>
 
 namespace tdc {
 
@@ -32,17 +33,18 @@ namespace huff {
         }
         return C;
     }
+    /// Counts the characters of a view, see \ref count_bytes.
+    inline len_compact_t* count_alphabet(const View& input) {
+        len_compact_t* C { new len_compact_t[ULITERAL_MAX+1] };
+        std::memset((void*)C, 0, sizeof(len_compact_t)*(ULITERAL_MAX+1));
+        count_bytes(input.data(), input.size(), C);
+        return C;
+    }
     template<class T>
     len_compact_t* count_alphabet_literals(T&& input) {
         len_compact_t* C { new len_compact_t[ULITERAL_MAX+1] };
         std::memset((void*)C, 0, sizeof(len_compact_t)*(ULITERAL_MAX+1));
-
-        while(input.has_next()) {
-            uliteral_t c = input.next().c;
-            DCHECK_LT(static_cast<uliteral_t>(c), ULITERAL_MAX+1);
-            DCHECK_LT(C[static_cast<uliteral_t>(c)], std::numeric_limits<len_compact_t>::max());
-            ++C[static_cast<uliteral_t>(c)];
-        }
+        count_literals(input, C);
         return C;
     }
     /** Computes an array that maps from the effective alphabet to the full alphabet.
@@ -473,7 +475,7 @@ namespace huff {
     }
 
     inline extended_huffmantable gen_huffmantable(const std::string& text) {
-        const len_compact_t*const C { count_alphabet(text) };
+        const len_compact_t*const C { count_alphabet(View(text)) };
         return gen_huffmantable(C);
     }
 
@@ -557,6 +559,7 @@ public:
         }
 
         using tdc::Encoder::encode; // default encoding as fallback
+        using tdc::Encoder::encode_many;
 
         template<typename value_t>
         inline void encode(value_t v, const LiteralRange&) {
@@ -566,6 +569,23 @@ public:
             else
                 huff::huffman_encode(v, *m_out, m_table.ordered_codelengths, ordered_map_to_effective, m_table.alphabet_size, m_table.codewords);
         }
+
+        template<typename iter_t>
+        inline void encode_many(iter_t begin, iter_t end, const LiteralRange&) {
+            DCHECK_NE(m_table.alphabet_size,0U);
+            BitPacker packer(*m_out);
+            if(tdc_unlikely(m_table.alphabet_size == 1)) {
+                for(; begin != end; ++begin) {
+                    packer.write_int(static_cast<uliteral_t>(*begin),8*sizeof(uliteral_t));
+                }
+            } else {
+                for(; begin != end; ++begin) {
+                    const uint8_t effective_char = ordered_map_to_effective[static_cast<uliteral_t>(*begin)];
+                    DCHECK_LT(effective_char, m_table.alphabet_size);
+                    packer.write_int(m_table.codewords[effective_char], m_table.ordered_codelengths[effective_char]);
+                }
+            }
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -601,6 +621,7 @@ public:
         }
 
         using tdc::Decoder::decode; // default decoding as fallback
+        using tdc::Decoder::decode_many;
 
         template<typename value_t>
         inline value_t decode(const LiteralRange&) {
@@ -608,6 +629,19 @@ public:
                 return m_in->read_int<uliteral_t>();
             return huff::huffman_decode(*m_in, ordered_map_from_effective, prefix_sum_lengths.get(), firstcodes);
         }
+
+        template<typename iter_t>
+        inline void decode_many(iter_t begin, iter_t end, const LiteralRange&) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+
+            if(tdc_unlikely(ordered_map_from_effective == nullptr)) {
+                for(; begin != end; ++begin) *begin = value_t(m_in->read_int<uliteral_t>());
+            } else {
+                for(; begin != end; ++begin) {
+                    *begin = value_t(huff::huffman_decode(*m_in, ordered_map_from_effective, prefix_sum_lengths.get(), firstcodes));
+                }
+            }
+        }
     };
 };
 
@@ -39,11 +39,22 @@ public:
         }
 
         using tdc::Encoder::encode;
+        using tdc::Encoder::encode_many;
 
         template<typename value_t>
         inline void encode(value_t v, const Range& r) {
             m_out->write_rice(v - value_t(r.min()), m_p);
         }
+
+        template<typename iter_t>
+        inline void encode_many(iter_t begin, iter_t end, const Range& r) {
+            const size_t min = r.min();
+
+            BitPacker packer(*m_out);
+            for(; begin != end; ++begin) {
+                write_rice<size_t>(packer.bit_sink(), size_t(*begin) - min, m_p);
+            }
+        }
     };
 
     /// \brief Decodes data from a stream of Elias-Delta codes.
@@ -62,11 +73,22 @@ public:
         }
 
         using tdc::Decoder::decode;
+        using tdc::Decoder::decode_many;
 
         template<typename value_t>
         inline value_t decode(const Range& r) {
             return value_t(r.min()) + m_in->read_rice<value_t>(m_p);
         }
+
+        template<typename iter_t>
+        inline void decode_many(iter_t begin, iter_t end, const Range& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+
+            const value_t min = value_t(r.min());
+            for(; begin != end; ++begin) {
+                *begin = min + m_in->read_rice<value_t>(m_p);
+            }
+        }
     };
 };
 
@@ -45,6 +45,12 @@ public:
                 }
             }
         }
+
+        /// Encodes each value separately, see \ref tdc::Encoder::encode_many.
+        template<typename iter_t, typename range_t>
+        inline void encode_many(iter_t begin, iter_t end, const range_t& r) {
+            for(; begin != end; ++begin) encode(*begin, r);
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -72,6 +78,13 @@ public:
 
             return v + value_t(r.min());
 		}
+
+        /// Decodes each value separately, see \ref tdc::Decoder::decode_many.
+        template<typename iter_t, typename range_t>
+        inline void decode_many(iter_t begin, iter_t end, const range_t& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+            for(; begin != end; ++begin) *begin = decode<value_t>(r);
+        }
     };
 };
 
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
+#include <type_traits>
+
 #include <tudocomp/util.hpp>
 #include <tudocomp/Coder.hpp>
 #include <tudocomp/util/Counter.hpp>
+#include <tudocomp/util/Histogram.hpp>
 
 namespace tdc {
 
@@ -78,49 +82,98 @@ public:
             return s.str();
         }
 
-    public:
-        template<typename literals_t>
-        inline Encoder(Config&& cfg, std::shared_ptr<BitOStream> out, literals_t&& literals)
-            : tdc::Encoder(std::move(cfg), out, literals) {
+        inline sym_t kmer_payload_mask() const {
+            return (sym_t(1) << (8UL * m_k)) - 1;
+        }
 
-            m_k = this->config().param("k").as_uint();
-            assert(m_k <= max_kmer);
+        /// Counts literals and k-mers from a view-backed literal iterator,
+        /// whose literals are all consecutive.
+        template<typename literals_t>
+        inline void count(
+            literals_t& literals,
+            size_t* literal_counts,
+            IntHistogram& kmer_counts,
+            std::true_type) {
+
+            const View view = literals.take_view();
+            count_bytes(view.data(), view.size(), literal_counts);
+
+            if(m_k > 1 && view.size() >= m_k) {
+                const sym_t mask = kmer_payload_mask();
+                sym_t x = 0;
+                for(size_t i = 0; i < m_k - 1; i++) x = (x << 8UL) | view[i];
+                for(size_t i = m_k - 1; i < view.size(); i++) {
+                    x = ((x << 8UL) | view[i]) & mask;
+                    kmer_counts.increase(x);
+                }
+            }
+        }
 
-            m_kmer = new uliteral_t[m_k];
-            m_kmer_cur = 0;
+        /// Counts literals and k-mers from any literal iterator. k-mers only
+        /// consist of literals at consecutive positions.
+        template<typename literals_t>
+        inline void count(
+            literals_t& literals,
+            size_t* literal_counts,
+            IntHistogram& kmer_counts,
+            std::false_type) {
+
+            const sym_t mask = kmer_payload_mask();
+            sym_t x = 0;
+            size_t len = 0;
             size_t last_literal_pos = 0;
 
-            Counter<sym_t> alphabet;
-            Counter<sym_t> kmers;
-
             while(literals.has_next()) {
                 Literal l = literals.next();
 
                 if(m_k > 1) {
-                    // update k-mer buffer
+                    // update k-mer
                     if(l.pos != last_literal_pos + 1) {
-                        m_kmer_cur = 0; //reset
+                        len = 0; //reset
                     }
 
-                    uliteral_t out;
-                    kmer_roll(l.c, out);
+                    x = ((x << 8UL) | l.c) & mask;
+                    if(len < m_k) ++len;
 
                     // count k-mer if complete
-                    if(kmer_full()) {
-                        auto x = compile_kmer(m_kmer, m_k);
-                        //DLOG(INFO) << "count k-mer: " << kmer_str() <<
-                        //    " => 0x" << std::hex << x;
-
-                        kmers.increase(x);
-                    }
+                    if(len == m_k) kmer_counts.increase(x);
                 }
 
                 // count single literal
-                alphabet.increase(sym_t(l.c));
+                ++literal_counts[l.c];
 
                 // save position
                 last_literal_pos = l.pos;
             }
+        }
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Config&& cfg, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(cfg), out, literals) {
+
+            m_k = this->config().param("k").as_uint();
+            assert(m_k <= max_kmer);
+
+            m_kmer = new uliteral_t[m_k];
+            m_kmer_cur = 0;
+
+            // count literals and k-mers
+            std::array<size_t, ULITERAL_MAX+1> literal_counts;
+            literal_counts.fill(0);
+            IntHistogram kmer_counts(m_k > 1 ? 8 * m_k : 0);
+            count(literals, literal_counts.data(), kmer_counts,
+                histogram::has_view<typename std::decay<literals_t>::type>());
+
+            Counter<sym_t> alphabet;
+            for(size_t c = 0; c <= ULITERAL_MAX; c++) {
+                if(literal_counts[c]) alphabet.setCount(sym_t(c), literal_counts[c]);
+            }
+
+            Counter<sym_t> kmers;
+            kmer_counts.for_each([&](uint64_t x, size_t n) {
+                kmers.setCount(sym_t(x) | kmer_mask, n);
+            });
 
             auto sigma = alphabet.getNumItems();
             m_sigma_bits = bits_for(sigma - 1);
@@ -286,6 +339,12 @@ public:
         inline void flush() {
             flush_kmer();
         }
+
+        /// Encodes each value separately, see \ref tdc::Encoder::encode_many.
+        template<typename iter_t, typename range_t>
+        inline void encode_many(iter_t begin, iter_t end, const range_t& r) {
+            for(; begin != end; ++begin) encode(*begin, r);
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -406,6 +465,13 @@ public:
             reset_kmer(); // current k-mer interrupted
             return tdc::Decoder::template decode<value_t>(r);
         }
+
+        /// Decodes each value separately, see \ref tdc::Decoder::decode_many.
+        template<typename iter_t, typename range_t>
+        inline void decode_many(iter_t begin, iter_t end, const range_t& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+            for(; begin != end; ++begin) *begin = decode<value_t>(r);
+        }
     };
 };
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+
 #include <tudocomp/util.hpp>
 #include <tudocomp/Coder.hpp>
+#include <tudocomp/util/Histogram.hpp>
 
 #include <tudocomp/ds/IntVector.hpp>
 #include <tudocomp/ds/Rank.hpp>
@@ -30,9 +33,13 @@ public:
             : tdc::Encoder(std::move(cfg), out, literals) {
 
             // find occuring characters
+            std::array<size_t, ULITERAL_MAX+1> counts;
+            counts.fill(0);
+            count_literals(literals, counts.data());
+
             m_bv = BitVector(ULITERAL_MAX+1, 0);
-            while(literals.has_next()) {
-                m_bv[literals.next().c] = 1;
+            for(size_t c = 0; c <= ULITERAL_MAX; c++) {
+                if(counts[c]) m_bv[c] = 1;
             }
 
             // employ rank support
@@ -58,12 +65,22 @@ public:
         }
 
         using tdc::Encoder::encode; // default encoding as fallback
+        using tdc::Encoder::encode_many;
 
         template<typename value_t>
         inline void encode(value_t v, const LiteralRange&) {
             DCHECK_GE(m_rank(v), 1U);
             m_out->write_int(m_rank(v)-1, m_sigma_bits);
         }
+
+        template<typename iter_t>
+        inline void encode_many(iter_t begin, iter_t end, const LiteralRange&) {
+            BitPacker packer(*m_out);
+            for(; begin != end; ++begin) {
+                DCHECK_GE(m_rank(*begin), 1U);
+                packer.write_int(m_rank(*begin)-1, m_sigma_bits);
+            }
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -96,12 +113,20 @@ public:
         }
 
         using tdc::Decoder::decode; // default decoding as fallback
+        using tdc::Decoder::decode_many;
 
 		template<typename value_t>
 		inline value_t decode(const LiteralRange&) {
             const size_t i = m_in->read_int<size_t>(m_sigma_bits);
             return m_alphabet[i];
         }
+
+        template<typename iter_t>
+        inline void decode_many(iter_t begin, iter_t end, const LiteralRange&) {
+            for(; begin != end; ++begin) {
+                *begin = m_alphabet[m_in->read_int<size_t>(m_sigma_bits)];
+            }
+        }
     };
 };
 
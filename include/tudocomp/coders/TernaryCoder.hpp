@@ -23,6 +23,12 @@ public:
         inline void encode(value_t v, const Range& r) {
             m_out->write_ternary(v - value_t(r.min()));
         }
+
+        /// Encodes each value separately, see \ref tdc::Encoder::encode_many.
+        template<typename iter_t, typename range_t>
+        inline void encode_many(iter_t begin, iter_t end, const range_t& r) {
+            for(; begin != end; ++begin) encode(*begin, r);
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -34,6 +40,13 @@ public:
         inline value_t decode(const Range& r) {
             return value_t(r.min()) + m_in->read_ternary<value_t>();
         }
+
+        /// Decodes each value separately, see \ref tdc::Decoder::decode_many.
+        template<typename iter_t, typename range_t>
+        inline void decode_many(iter_t begin, iter_t end, const range_t& r) {
+            using value_t = typename std::iterator_traits<iter_t>::value_type;
+            for(; begin != end; ++begin) *begin = decode<value_t>(r);
+        }
     };
 };
 
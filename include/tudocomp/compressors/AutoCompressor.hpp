@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/io.hpp>
+#include <tudocomp/meta/Registry.hpp>
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/Tags.hpp>
+#include <tudocomp/decompressors/AutoDecompressor.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+// For default params
+#include <tudocomp/coders/BinaryCoder.hpp>
+#include <tudocomp/compressors/LZ78Compressor.hpp>
+#include <tudocomp/compressors/LZSSSlidingWindowCompressor.hpp>
+#include <tudocomp/compressors/RePairCompressor.hpp>
+#include <tudocomp/compressors/lz_trie/TernaryTrie.hpp>
+#include <tudocomp/compressors/lzss/StreamingCoder.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace tdc {
+
+/// Compresses the input with the best of several candidate compressors.
+///
+/// Every candidate compresses a few blocks sampled evenly from the input,
+/// in parallel. The candidate that fits the objective best on the samples
+/// then compresses the whole input:
+///
+/// - `ratio` selects the smallest output,
+/// - `speed` selects the fastest candidate,
+/// - `balanced` selects the fastest candidate whose output is at most
+///   10% larger than the smallest one.
+///
+/// The configuration of the selected decompressor is written in front of
+/// the output, so the \ref AutoDecompressor can restore the input.
+///
+/// Candidates tagged `require_sentinel` compress the sampled blocks and the
+/// input with a sentinel appended. The candidates are only known at runtime,
+/// so the restrictions are recorded after the decompressor configuration
+/// rather than propagated to the tags of this compressor.
+class AutoCompressor : public Compressor {
+    struct Trial {
+        bool ok = true;
+        size_t bytes = 0;
+        double seconds = 0;
+        std::string error;
+    };
+
+    using entry_t = RegistryOf<Compressor>::Entry;
+
+    /// Returns the input restrictions required by the candidate.
+    inline static InputRestrictions restrictions(const entry_t& entry) {
+        return entry.has_tag(tags::require_sentinel)
+            ? InputRestrictions::sentinel() : InputRestrictions::none();
+    }
+
+    inline std::vector<entry_t> candidates() const {
+        std::vector<entry_t> entries;
+        auto list = meta::ast::convert<meta::ast::List>(
+            config().param("candidates").ast());
+        for(auto& item : list->items()) {
+            entries.push_back(Registry::of<Compressor>().find(
+                meta::ast::convert<meta::ast::Object>(item)));
+        }
+        return entries;
+    }
+
+    /// Returns the `[begin, end)` ranges of the sampled blocks.
+    inline std::vector<std::pair<size_t, size_t>> sample_blocks(size_t n) const {
+        const size_t num_blocks = std::max<size_t>(1, config().param("blocks").as_uint());
+        const size_t block_size = std::max<size_t>(1, config().param("block_size").as_uint());
+
+        std::vector<std::pair<size_t, size_t>> blocks;
+        if(n <= num_blocks * block_size) {
+            // the whole input is the sample
+            if(n > 0) blocks.emplace_back(0, n);
+        } else {
+            for(size_t i = 0; i < num_blocks; ++i) {
+                const size_t begin = (num_blocks > 1)
+                    ? (n - block_size) * i / (num_blocks - 1) : 0;
+                blocks.emplace_back(begin, begin + block_size);
+            }
+        }
+        return blocks;
+    }
+
+    /// Selects the candidate that fits the objective best.
+    inline size_t select(const std::vector<Trial>& trials) const {
+        const std::string objective = config().param("objective").as_string();
+        if(objective != "ratio" && objective != "speed" && objective != "balanced") {
+            throw std::runtime_error("unknown objective: " + objective);
+        }
+
+        size_t min_bytes = std::numeric_limits<size_t>::max();
+        for(auto& t : trials) {
+            if(t.ok) min_bytes = std::min(min_bytes, t.bytes);
+        }
+
+        auto better = [&](const Trial& a, const Trial& b) {
+            if(objective == "ratio") {
+                return a.bytes < b.bytes || (a.bytes == b.bytes && a.seconds < b.seconds);
+            } else if(objective == "speed") {
+                return a.seconds < b.seconds;
+            } else {
+                const size_t max_bytes = min_bytes + min_bytes / 10;
+                const bool a_fits = a.bytes <= max_bytes;
+                const bool b_fits = b.bytes <= max_bytes;
+                return (a_fits && !b_fits) || (a_fits == b_fits && a.seconds < b.seconds);
+            }
+        };
+
+        size_t best = trials.size();
+        for(size_t i = 0; i < trials.size(); ++i) {
+            if(!trials[i].ok) continue;
+            if(best == trials.size() || better(trials[i], trials[best])) best = i;
+        }
+
+        if(best == trials.size()) {
+            throw std::runtime_error("no candidate compressor succeeded on the samples");
+        }
+        return best;
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m(Compressor::type_desc(), "auto",
+            "Compresses the input with the best of several compressors, "
+            "which is selected on sampled blocks of the input.");
+        m.param("candidates", "The compressors to choose from.")
+            .unbound_strategy_list(Compressor::type_desc(),
+                Meta::Defaults<
+                    LZ78Compressor<BinaryCoder, lz_trie::TernaryTrie>,
+                    LZSSSlidingWindowCompressor<
+                        lzss::StreamingCoder<BinaryCoder, BinaryCoder, BinaryCoder>>,
+                    RePairCompressor<BinaryCoder>>());
+        m.param("objective",
+            "The selection objective: ratio, speed or balanced.")
+            .primitive("balanced");
+        m.param("blocks", "The number of sampled blocks.").primitive(4);
+        m.param("block_size", "The size of each sampled block (in bytes).")
+            .primitive(64 * 1024);
+        return m;
+    }
+
+    using Compressor::Compressor;
+
+    inline virtual void compress(Input& input, Output& output) override final {
+        const auto entries = candidates();
+        if(entries.empty()) {
+            throw std::runtime_error("no candidate compressors");
+        }
+
+        std::vector<Trial> trials(entries.size());
+        size_t best = 0;
+
+        StatPhase::wrap("Select compressor", [&]{
+            const auto blocks = sample_blocks(input.size());
+            if(entries.size() < 2 || blocks.empty()) return;
+
+            // the trials run concurrently, which phase tracking does not support
+            StatPhase::pause_tracking();
+
+            const size_t num_jobs = entries.size() * blocks.size();
+            std::vector<Trial> jobs(num_jobs);
+
+            #ifdef ENABLE_OPENMP
+            #pragma omp parallel for schedule(dynamic, 1)
+            #endif
+            for(size_t j = 0; j < num_jobs; ++j) {
+                const auto& block = blocks[j % blocks.size()];
+                const auto& entry = entries[j / blocks.size()];
+                try {
+                    auto compressor = entry.select().move_instance();
+
+                    std::vector<uint8_t> buffer;
+                    Input block_input(input, block.first, block.second);
+                    Output block_output(buffer);
+
+                    const auto start = std::chrono::steady_clock::now();
+                    const InputRestrictions r = restrictions(entry);
+                    if(r.has_restrictions()) {
+                        Input restricted(block_input, r);
+                        compressor->compress(restricted, block_output);
+                    } else {
+                        compressor->compress(block_input, block_output);
+                    }
+                    jobs[j].seconds = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start).count();
+                    jobs[j].bytes = buffer.size();
+                } catch(std::exception& e) {
+                    jobs[j].ok = false;
+                    jobs[j].error = e.what();
+                }
+            }
+
+            StatPhase::resume_tracking();
+
+            size_t num_failed = 0;
+            for(size_t j = 0; j < num_jobs; ++j) {
+                Trial& t = trials[j / blocks.size()];
+                if(t.ok && !jobs[j].ok) {
+                    LOG(WARNING) << "candidate "
+                        << entries[j / blocks.size()].select().instance().config().str()
+                        << " failed on a sampled block: " << jobs[j].error;
+                    ++num_failed;
+                }
+                t.ok = t.ok && jobs[j].ok;
+                t.bytes += jobs[j].bytes;
+                t.seconds += jobs[j].seconds;
+            }
+
+            best = select(trials);
+
+            size_t sample_size = 0;
+            for(auto& block : blocks) sample_size += block.second - block.first;
+
+            StatPhase::log("sample size", sample_size);
+            StatPhase::log("failed candidates", num_failed);
+            StatPhase::log("selected", entries[best].select().instance().config().str());
+            StatPhase::log("selected ratio", double(trials[best].bytes) / sample_size);
+            StatPhase::log("selected time (s)", trials[best].seconds);
+        });
+
+        auto compressor = entries[best].select().move_instance();
+        const InputRestrictions r = restrictions(entries[best]);
+
+        // record the decompressor and the restrictions to undo
+        {
+            auto os = output.as_stream();
+            os << compressor->decompressor()->config().str() << '\0';
+            r.serialize(os);
+        }
+
+        if(r.has_restrictions()) {
+            Input restricted(input, r);
+            compressor->compress(restricted, output);
+        } else {
+            compressor->compress(input, output);
+        }
+    }
+
+    inline virtual std::unique_ptr<Decompressor> decompressor() const override {
+        return Algorithm::instance<AutoDecompressor>();
+    }
+};
+
+}
@@ -23,6 +23,9 @@ public:
         Meta m(Compressor::type_desc(), "esp", "ESP based grammar compression");
         m.param("slp_coder").strategy<slp_coder_t>(TypeDesc("slp_coder"), Meta::Default<esp::PlainSLPCoder>());
         m.param("ipd").strategy<ipd_t>(TypeDesc("ipd"), Meta::Default<esp::StdUnorderedMapIPD>());
+        m.param("threads",
+            "The number of threads used to build each grammar level "
+            "(0 = as many as available).").primitive(1);
         return m;
     }
 
@@ -33,7 +36,7 @@ public:
 
         StatPhase phase0("ESP Compressor");
 
-        EspContext<ipd_t> context;
+        EspContext<ipd_t> context { this->config().param("threads").as_uint() };
         SLP slp { SLP_CODING_ALPHABET_SIZE };
 
         {
@@ -1,511 +1,281 @@
 #pragma once
 
 #include <algorithm>
-#include <functional>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/Range.hpp>
 #include <tudocomp/Tags.hpp>
 #include <tudocomp/util.hpp>
+#include <tudocomp/util/Trace.hpp>
 
 #include <tudocomp/decompressors/LZSSDecompressor.hpp>
 
-//custom
-
-#include <unordered_map>
-#include <string>
-#include <tuple>
-#include <iostream>
-#include <deque>
-
-#include <tudocomp/def.hpp>
-#include <tudocomp/util/compact_hash/map/typedefs.hpp>
-
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
+#include <tudocomp/compressors/lzss/FactorizationStats.hpp>
 #include <tudocomp/compressors/lzss/UnreplacedLiterals.hpp>
 
-#include <tudocomp/compressors/lz77Aprox/AproxFactor.hpp>
 #include <tudocomp/compressors/lz77Aprox/Cherry.hpp>
-#include <tudocomp/compressors/lz77Aprox/hash_interface.hpp>
-#include <tudocomp/compressors/lz77Aprox/stackoverflow_hash.hpp>
-
-namespace tdc
-{
-    template <typename lzss_coder_t>
-    class LZ77AproxCompressor : public Compressor
-    {
-
-    private:
-        struct cherry_child_ref
-        {
-            bool right;
-            std::set<Cherry>::iterator index;
-        };
-
-        struct hmap_value
-        {
-            cherry_child_ref first_factor;
-           
-        };
-
-        //this is ugly
-        len_t WINDOW_SIZE  ;
-        len_t MIN_FACTOR_LENGTH;
-
-        std::set<Cherry> FactorBuffer;
-        hash_interface *hash_provider;
-
-        rolling_hash rhash;
-
-        inline long long get_factor_hash(AproxFactor &fac, io::InputView &input_view) { return hash_provider->make_hash(fac.position, fac.length, input_view); }
-
-        inline long long get_factor_hash_left(Cherry &fac, io::InputView &input_view) { return hash_provider->make_hash(fac.position, (fac.length / 2), input_view); }
-
-        inline long long get_factor_hash_right(Cherry &fac, io::InputView &input_view) { return hash_provider->make_hash(fac.position + fac.length / 2, fac.length / 2, input_view); }
-
-        //this function fills the FactorBuffer with the "first row" of the "tree"
-        //TODO typedef FactorFlags cause they are ugly now (and unreadable)
-        void populate_buffer(len_t window_size, io::InputView &input_view)
-        {
-            len_t position(0);
-            //run until the next factor would reach beyond the file
-
-            for (len_t i = 0; i <= input_view.size() - 1 - window_size; i = i + window_size)
-            {
-
-                FactorBuffer.emplace(Cherry(position, window_size, 0));
-                ;
-
-                //cant use i after scope but must know pos for eof handle
-                //if you use position in loop last step will be missing and you dont know if it its exactly
-                position = position + window_size;
-            }
-
-            //marks the last factor as eof-factor if the Factor border lies beyond the end of the file
-            //note that only the very last Factor in the Buffer can have flag 7 so only ever check the last factor for this case
-            if (position < input_view.size())
-            {
-                FactorBuffer.emplace(Cherry(position, window_size, 7));
-            }
+#include <tudocomp/compressors/lz77Aprox/FingerprintTable.hpp>
+#include <tudocomp/compressors/lz77Aprox/KarpRabinHash.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace tdc {
+
+/// Computes an approximation of the LZ77 factorization of the input.
+///
+/// The text is partitioned into blocks (cherries) of the window size. In
+/// each round, the two halves of every remaining cherry are searched for
+/// an earlier occurrence in the text using Karp-Rabin fingerprints. Halves
+/// that have one become factors, the others become the cherries of the
+/// next round, which halves the length until the threshold is reached.
+///
+/// The search of a round is a single scan of a rolling fingerprint over
+/// the text, which is split into chunks that are scanned in parallel. The
+/// leftmost occurrences found in the chunks are merged afterwards.
+/// Fingerprint matches are verified, so the factorization is exact.
+template <typename lzss_coder_t>
+class LZ77AproxCompressor : public Compressor {
+private:
+    using Cherry = lz77Aprox::Cherry;
+
+    // state of the current round, kept to reuse the memory across rounds
+    std::vector<Cherry> m_cherries;
+    std::vector<Cherry> m_next_cherries;
+    std::vector<uint64_t> m_fingerprints;     // the fingerprint of each child
+    std::vector<len_compact_t> m_child_entry; // the distinct string of each child
+    std::vector<len_compact_t> m_entry_pos;   // the first child of each distinct string
+    std::vector<len_compact_t> m_leftmost;    // the leftmost occurrence of each distinct string
+    std::vector<std::vector<len_compact_t>> m_chunk_leftmost;
+    lz77Aprox::FingerprintTable m_table;
+
+    inline static size_t num_threads() {
+#ifdef ENABLE_OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    /// Collects the distinct strings among the children of the cherries,
+    /// which have to lie completely inside the text.
+    inline void collect_children(const View& text, const lz77Aprox::KarpRabinHash& kr) {
+        const len_t n = text.size();
+        const len_t h = kr.length();
+        const len_t num_children = 2 * m_cherries.size();
+
+        m_fingerprints.resize(num_children);
+
+        #ifdef ENABLE_OPENMP
+        #pragma omp parallel for schedule(static)
+        #endif
+        for(size_t c = 0; c < num_children; ++c) {
+            const Cherry& cherry = m_cherries[c / 2];
+            const len_t pos = (c % 2) ? cherry.right() : cherry.left();
+            if(pos + h <= n) m_fingerprints[c] = kr.hash(text.data() + pos);
         }
 
-        //scans the FactorBuffer for all cherrys to be tested
-        void make_active_cherry_list(std::vector<std::set<Cherry>::iterator> &vec)
-        {
-            for (auto iter = FactorBuffer.begin(); iter != FactorBuffer.end(); iter++)
-            {
-                if ((*iter).status == 0 || (*iter).status == 7)
-                {
-                    vec.push_back(iter);
-                }
-            }
+        m_table.reset(num_children);
+        m_child_entry.assign(num_children, len_compact_t(INDEX_MAX));
+        m_entry_pos.clear();
+
+        // the first child of each string in text order represents it
+        for(size_t c = 0; c < num_children; ++c) {
+            const Cherry& cherry = m_cherries[c / 2];
+            const len_t pos = (c % 2) ? cherry.right() : cherry.left();
+            if(pos + h > n) continue;
+
+            const len_t entry = m_table.insert(
+                m_fingerprints[c], m_entry_pos.size(), [&](len_t e){
+                    return std::memcmp(text.data() + m_entry_pos[e],
+                                       text.data() + pos, h) == 0;
+                });
+            if(entry == m_entry_pos.size()) m_entry_pos.push_back(pos);
+            m_child_entry[c] = entry;
         }
-
-        //searches with the rolling hash over the view and marks all children of the cherrys if found
-        void mark_cherrys(std::unordered_map<long long, hmap_value> &hmap, std::unordered_map<long long, len_t> &storage, io::InputView &input_view)
-        {
-            //dont let the hash rollbeyond the view
-            //main loop over the entire view
-            for (len_t i = 0; i < input_view.size() - 1 - rhash.length; i++)
-            {
-
-                //check if key exists
-                if (hmap.end() != hmap.find(rhash.hashvalue))
-                {
-                    if (hmap[rhash.hashvalue].first_factor.right)
-                    {
-                        if (rhash.position < (*hmap[rhash.hashvalue].first_factor.index).position +
-                                                 (*hmap[rhash.hashvalue].first_factor.index).length / 2)
-                        {
-                            //rolling hash matches and lies before the first factor
-                            
-                            (*hmap[rhash.hashvalue].first_factor.index).rightfound = true;
-                        }
-                    }
-                    else
-                    {
-                        //left factor
-                        if (rhash.position < (*hmap[rhash.hashvalue].first_factor.index).position)
-                        {
-                            //rolling hash matches and lies before the first factor
-                            
-                            (*hmap[rhash.hashvalue].first_factor.index).leftfound = true;
-                        }
+    }
+
+    /// Finds the leftmost occurrence of each distinct child string.
+    inline void scan(const View& text, const lz77Aprox::KarpRabinHash& kr) {
+        const len_t h = kr.length();
+        const size_t num_entries = m_entry_pos.size();
+
+        // a string occurs at its first child at the latest,
+        // so the scan can stop at the rightmost first child
+        len_t scan_end = 0;
+        for(len_t pos : m_entry_pos) scan_end = std::max(scan_end, pos);
+
+        const size_t threads = std::max<size_t>(1,
+            std::min<size_t>(num_threads(), scan_end / (1 << 16)));
+        const len_t chunk = idiv_ceil(scan_end, threads);
+        m_chunk_leftmost.resize(threads);
+
+        #ifdef ENABLE_OPENMP
+        #pragma omp parallel for schedule(static, 1) num_threads(threads)
+        #endif
+        for(size_t t = 0; t < threads; ++t) {
+            Trace::Scope trace("lz77Aprox scan");
+
+            auto& leftmost = m_chunk_leftmost[t];
+            leftmost.assign(m_entry_pos.begin(), m_entry_pos.end());
+
+            const len_t begin = t * chunk;
+            const len_t end = std::min<len_t>(begin + chunk, scan_end);
+            if(begin >= end) continue;
+
+            const uliteral_t* s = text.data();
+            uint64_t fp = kr.hash(s + begin);
+            for(len_t p = begin;;) {
+                m_table.find(fp, [&](len_t e){
+                    if(p < leftmost[e] && std::memcmp(s + p, s + m_entry_pos[e], h) == 0) {
+                        leftmost[e] = p;
                     }
+                });
 
-                    //storage
-                    storage[rhash.hashvalue] = rhash.position;
-
-                    //rolling hash reached the first occurence
-                    // we cant find it beyond here
-                    //so remove it from the hmap
-                    hmap.erase(rhash.hashvalue);
-                }
-                hash_provider->advance_rolling_hash(rhash,input_view);
+                if(++p == end) break;
+                fp = kr.roll(fp, s[p - 1], s[p + h - 1]);
             }
-            hmap.clear();
         }
 
-        //inserts the childern of a factor correctly into an unordered map
-        //to correnctly set the first occurence insert factors from left to right
-        void insert_factor(std::unordered_map<long long, hmap_value> &hmap, std::set<Cherry>::iterator &index, io::InputView &input_view)
-        {
-
-            //doesnt work otherwise dunno why
-            Cherry k = *index;
-            long long hash = get_factor_hash_left(k, input_view);
-
-            //std::cout << "1" << std::endl;
-            //left key exists
-            if (hmap.end() != hmap.find(hash))
-            {
-                //if key exist before this one we only need to search thefirst of those
-                (*index).leftfound = true;
-            }
-            else
-            {
-                //left key doesnt exist before set first_occ to position of factor
-                hmap[hash] = hmap_value{cherry_child_ref{false, index}};
-            }
-            hash = get_factor_hash_right(k, input_view);
-            //std::cout << "2" << std::endl;
-            //right key exists
-            if (hmap.end() != hmap.find(hash))
-            {
-                //if key exist before this one we only need to search thefirst of those
-                (*index).rightfound = true;
-            }
-            else
-            {
-                //right key doesnt exist before set first_occ to position of factor
-                hmap[hash] = hmap_value{cherry_child_ref{true, index}};
-            }
-        }
-
-        void populate_multimap(std::unordered_map<long long, hmap_value> &hmap, std::vector<std::set<Cherry>::iterator> &cherrylist, io::InputView &input_view)
-        {
-            hmap.reserve(cherrylist.size());
-
-            for (len_t iter = 0; iter < cherrylist.size() - 1; iter++)
-            {
-                insert_factor(hmap, cherrylist[iter], input_view);
-            }
-            Cherry c = (*cherrylist.back());
-            //handle eof
-            if ((*cherrylist.back()).status == 7)
-            {
-                len_t bull = c.position;
-                len_t shit = c.length / 2;
-                len_t bullshit = bull + shit - 1; //-1 to account for the fact that we dont start at 0
-
-                if (bullshit >= input_view.size() - 1)
-                {
-                    //leftchild also reaches Beyond
-                    c.split();
-                    c.status = 7;
-                    //erase old Cherry
-                    FactorBuffer.erase(cherrylist.back());
-                    //add new Cherry
-                    FactorBuffer.insert(c);
-                    //new Cherry ist active and iter is invalid
-                    cherrylist.pop_back();
-                }
-                else
-                {
-                    //only the right child reaches into the beyond
-                    long long hash = get_factor_hash_left(c,input_view);
-                    //left key exists
-                    if (hmap.end() != hmap.find(hash))
-                    {
-                        cherrylist.back()->leftfound = true;
-                    }
-                    else
-                    {
-                        //left key doesnt exist before set first_occ to position of factor
-                        hmap[hash] = hmap_value{cherry_child_ref{false, cherrylist.back()}};
-                    }
+        // merge the chunks, the leftmost occurrence is found in the first one
+        m_leftmost.assign(m_entry_pos.begin(), m_entry_pos.end());
+        for(size_t e = 0; e < num_entries; ++e) {
+            for(size_t t = 0; t < threads; ++t) {
+                if(m_chunk_leftmost[t][e] < m_leftmost[e]) {
+                    m_leftmost[e] = m_chunk_leftmost[t][e];
+                    break;
                 }
             }
-            else
-            {
-                // last one isnt eof factor
-                insert_factor(hmap, cherrylist.back(), input_view);
-            }
         }
+    }
 
-        void apply_findings(std::vector<std::set<Cherry>::iterator> &cherrylist)
-        {
+    /// Turns the children with an earlier occurrence into factors and
+    /// determines the cherries of the next round.
+    template<typename factor_buffer_t>
+    inline void apply_findings(len_t n, len_t h, factor_buffer_t& factors) {
+        m_next_cherries.clear();
 
-            Cherry c;
-
-            for (std::set<Cherry>::iterator iter : cherrylist)
-            {
-
-                switch ((*iter).rightfound * 1 + (*iter).leftfound * 2)
-                {
-                case 0:
-                    //neither left nor right found -> new cherry
-                    FactorBuffer.emplace((*iter).split());
-
-                    break;
-                case 1:
-                    //only right found
-                    (*iter).only_rightfound();
+        auto source = [&](size_t c, len_t pos) -> len_t {
+            const len_t e = m_child_entry[c];
+            return (e != INDEX_MAX && m_leftmost[e] < pos) ? len_t(m_leftmost[e]) : pos;
+        };
 
-                    break;
-                case 2:
-                    //only leftfound
-                    c = (*iter);
-                    FactorBuffer.erase(iter);
-                    c.only_leftfound();
-                    FactorBuffer.insert(c);
+        for(size_t i = 0; i < m_cherries.size(); ++i) {
+            const Cherry& cherry = m_cherries[i];
+            const len_t left = cherry.left();
+            const len_t right = cherry.right();
 
-                    break;
-                case 3: //cherrydone
-                    (*iter).status = 1;
+            const len_t left_src = source(2 * i, left);
+            const len_t right_src = source(2 * i + 1, right);
+            const bool left_found = left_src < left;
+            const bool right_found = right_src < right;
 
-                    break;
-                }
+            if(left_found) {
+                factors.emplace_back(left, left_src, h);
+            } else {
+                m_next_cherries.push_back(Cherry { left, h });
             }
-        }
-
-
-        void inflate_chains(std::deque<AproxFactor> &facbuf, io::InputView &input_view)
-        {
-
-            unsigned long long k = 0;
-
-            len_t length = 0;
-            len_t position = 0;
-            Cherry c;
-            Cherry last = *(std::prev(FactorBuffer.end()));
-            FactorBuffer.erase(std::prev(FactorBuffer.end()));
-            //std::cout << "tt test" << std::endl;
-           while(!FactorBuffer.empty())
-            {
-                c=(*FactorBuffer.begin());
-                FactorBuffer.erase(FactorBuffer.begin());
-                while (c.l > 0)
-                {
-                    k = (63 - __builtin_clzll(c.l));
-                    length = 1 << k;
-                    facbuf.push_back(AproxFactor(position, length, 2));
-                    c.l = c.l - length;
-                    position = position + length;
-                }
 
-                //if(position!=c.position){
-                //    std::cout <<"pos: "<<position<<"c.pos: "<<c.position<<std::endl;
-                //    throw std::invalid_argument( "not ordered" );
-                //}
-
-                facbuf.push_back(AproxFactor(c.position, c.length / 2, 2));
-                facbuf.push_back(AproxFactor(c.position + c.length / 2, c.length / 2, 2));
-
-                position = c.position + c.length;
-                while (c.r > 0)
-                {
-                    k = (__builtin_ctzll(c.r));
-                    length = 1 << k;
-                    facbuf.push_back(AproxFactor(position, length, 2));
-                    c.r = c.r - length;
-                    position = position + length;
-                }
-                
-            }
-            //eof
-            while (last.l > 0)
-            {
-                k = (63 - __builtin_clzll(last.l));
-                length = 1 << k;
-                facbuf.push_back(AproxFactor(position, length, 2));
-                last.l = last.l - length;
-                position = position + length;
+            if(right_found) {
+                factors.emplace_back(right, right_src, h);
+            } else if(right < n) {
+                // the right child may lie beyond the end of the text
+                m_next_cherries.push_back(Cherry { right, h });
             }
-            facbuf.push_back(AproxFactor(last.position, input_view.size() - last.position, 2));
         }
 
-        len_t tree_level_by_size(len_t size)
-        {
-            len_t i = 0;
-            len_t ws = WINDOW_SIZE / 2; //half because we test the children not the thing itself
-            while (ws != size)
-            {
-                ws = ws / 2;
-                i++;
-            }
-            return i;
+        std::swap(m_cherries, m_next_cherries);
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m(Compressor::type_desc(), "lz77Aprox",
+               "Computes an approximate LZSS-parse by halving blocks of the "
+               "input until their halves occur earlier in the text.");
+        m.param("coder", "The output encoder.")
+            .strategy<lzss_coder_t>(TypeDesc("lzss_coder"));
+        m.param("window", "The starting window size, a power of two.")
+            .primitive(16);
+        m.param("threshold", "The minimum factor length.").primitive(2);
+        m.inherit_tag<lzss_coder_t>(tags::lossy);
+        return m;
+    }
+
+    using Compressor::Compressor;
+
+    inline virtual void compress(Input& input, Output& output) override {
+        auto view = input.as_view();
+        const len_t n = view.size();
+
+        const len_t threshold = std::max<len_t>(1, config().param("threshold").as_uint());
+
+        const uint64_t window_param = config().param("window").as_uint();
+        if(window_param == 0 || (window_param & (window_param - 1)) != 0) {
+            throw std::invalid_argument(
+                "window is not a power of two: " + std::to_string(window_param));
         }
 
-        void insert_first_occ(std::deque<AproxFactor> &facbuf, std::vector<std::unordered_map<long long,len_t>> &map_storage, io::InputView &input_view)
-        {
-            len_t x= __builtin_clz(WINDOW_SIZE/2);
-            for (len_t i = 0; i < facbuf.size(); i++)
-            {
-
-                AproxFactor c = facbuf[i];
-                //get the right bucket
-                len_t k = __builtin_clz(c.length)-x;
-                //skip literals
-                if (k > map_storage.size() - 1)
-                {
-                    continue;
-                }
-                long long h = get_factor_hash(c, input_view);
-
-                if (map_storage[k].end() != map_storage[k].find(h))
-                {
-                    //if((map_storage[k])[h]>facbuf[i].position){
-                    //    std::cout<<"src: "<<(map_storage[k])[h]<<" pos: "<<facbuf[i].position<<std::endl;
-                    //    std::cout<<"src: "<<input_view.substr( (map_storage[k])[h], facbuf[i].length)<<" pos: "<< input_view.substr(facbuf[i].position,facbuf[i].length)<<std::endl;
-                    //    throw std::invalid_argument( "forward reference" );
-                    //}
-                    facbuf[i].firstoccurence = (map_storage[k])[h];
-                }
-            }
-        }
+        // the window is the length of the children in the first round
+        len_t window = len_t(window_param) * 2;
+        while(window > 1 && window > n) window /= 2;
 
-    public:
-        inline static Meta meta()
-        {
-            Meta m(Compressor::type_desc(), "lz77Aprox",
-                   "Computes a LZSS-parse based on binarytree-partioning "
-                   "and merging of the resulting factors.");
-            //do not remove you will get registery error
-            //m.param must match template params and registery sub
-            m.param("coder", "The output encoder.")
-                .strategy<lzss_coder_t>(TypeDesc("lzss_coder"));
-            m.param("window", "The starting window size").primitive(16);
-            m.param("threshold", "The minimum factor length.").primitive(2);
-            m.inherit_tag<lzss_coder_t>(tags::lossy);
-
-            return m;
-        }
+        lzss::FactorBufferRAM factors;
 
-        using Compressor::Compressor;
-
-        inline virtual void compress(Input &input, Output &output) override
-        {
-            io::InputView input_view = input.as_view();
-            WINDOW_SIZE=config().param("window").as_int() *2;
-            MIN_FACTOR_LENGTH= config().param("threshold").as_int();
-            //std::cout << "ws:"<<WINDOW_SIZE << std::endl;
-            //std::cout << "mfl: "<<MIN_FACTOR_LENGTH << std::endl;
-            
-            auto os = output.as_stream();
-            //choose hash here
-            hash_provider = new stackoverflow_hash();
-
-            auto map = tdc::compact_hash::map::sparse_cv_hashmap_t<int>(0, 4);
-            //make reusable containers
-            std::vector<std::unordered_map<long long, len_t>> map_storage;
-            std::unordered_map<long long, hmap_value> hmap;
-            std::vector<std::set<Cherry>::iterator> cherrylist;
-            std::unordered_map<long long, len_t> temp_store;
-
-            //adjust window size
-            while (input_view.size() - 1 < WINDOW_SIZE)
-            {
-                WINDOW_SIZE = WINDOW_SIZE / 2;
+        StatPhase::wrap("Factorization", [&]{
+            m_cherries.clear();
+            for(len_t pos = 0; pos < n; pos += window) {
+                m_cherries.push_back(Cherry { pos, window });
             }
 
-            //init the buffer
-            populate_buffer(WINDOW_SIZE, input_view);
-
-            len_t ws = WINDOW_SIZE;
-            //std::cout << "ws:" << ws << ",MINFACTORLENGTH: " << MIN_FACTOR_LENGTH << std::endl;
-            len_t round = 0;
-
-            //start Phase1 loop
-            StatPhase::wrap("Factorization", [&] {
-                while (ws > MIN_FACTOR_LENGTH)
-                {
-
-                    StatPhase::wrap("Round: " + std::to_string(round), [&] {
-                       // std::cout << FactorBuffer.size() << std::endl;
-                        StatPhase::log("numbers of cherrys", FactorBuffer.size());
-                        //std::cout << "0" << std::endl;
-                        StatPhase::wrap("cherrylist: ", [&] { make_active_cherry_list(cherrylist); });
-                        //std::cout << "1" << std::endl;
-                        //std::cout << "active: " << cherrylist.size() << std::endl;
-                        StatPhase::log("numbers of active cherrys", cherrylist.size());
-                        rhash = hash_provider->make_rolling_hash(0, ws / 2, input_view); //half because we test the children
-                        //std::cout << "2" << std::endl;
-                       
-                        StatPhase::wrap("make multimap: ", [&] { populate_multimap(hmap, cherrylist, input_view); });
-                        std::cout << "3" << std::endl;
-                       
-                        StatPhase::wrap("mark cherrys: ", [&] { mark_cherrys(hmap, temp_store, input_view); });
-                        std::cout << "4" << std::endl;
-                        hmap =  std::unordered_map<long long, hmap_value>();
-                       
-                        StatPhase::wrap("store map: ", [&] {map_storage.push_back(temp_store);});
-                        temp_store =  std::unordered_map<long long,len_t>();
-                        StatPhase::wrap("apply findings: ", [&] { apply_findings(cherrylist); });
-                        ws = ws / 2;
-                        cherrylist.clear();
-                        
-                        round++;
-                        std::cout<<"level done"<<std::endl;
+            size_t round = 0;
+            for(len_t ws = window; ws > threshold && !m_cherries.empty(); ws /= 2) {
+                StatPhase::wrap("Round " + std::to_string(round++), [&]{
+                    StatPhase::log("cherries", m_cherries.size());
+
+                    const lz77Aprox::KarpRabinHash kr(ws / 2);
+                    StatPhase::wrap("Fingerprint children", [&]{
+                        collect_children(view, kr);
+                        StatPhase::log("distinct children", m_entry_pos.size());
                     });
-                }
-            });
-            std::cout << "fac done." << std::endl;
-
-
-
-           
-            len_t il = 0;
-
-
-            std::deque<AproxFactor> facbuf;
-            
-            StatPhase::wrap("inflate chains: ", [&] {inflate_chains(facbuf,input_view);});
-            FactorBuffer.clear();
-            
-            
-            std::cout << "inflate done. facbuf size: "<<facbuf.size() << std::endl;
-            StatPhase::wrap("insert src: ", [&] {insert_first_occ(facbuf, map_storage,input_view);});
-            map_storage.clear();
-            map_storage.shrink_to_fit();
-            std::cout << "start encode." << std::endl;
-            lzss::FactorBufferRAM factors;
-            delete hash_provider;
-            int last_pos =0;
-            il = 0;
-            
-           for(AproxFactor f:facbuf){
-                
-                    if (f.firstoccurence != f.position)
-                    {
-                        if ((f.position <= last_pos)&&(last_pos!=0))
-                        {   
-                            std::cout << "il: " << il << " last_pos: " << last_pos << "  pos: " << f.position << std::endl;
-                            throw std::invalid_argument("not sorted");
-                        }
-                        factors.push_back(f.position, f.firstoccurence, f.length);
-                        last_pos = f.position;
-                        il++;
-                        
-                    }
-                  
+                    StatPhase::wrap("Scan", [&]{
+                        scan(view, kr);
+                    });
+                    StatPhase::wrap("Apply findings", [&]{
+                        apply_findings(n, ws / 2, factors);
+                    });
+                });
             }
-            facbuf.shrink_to_fit();
-            std::cout<<"found facs: "<<il<<std::endl;
 
-            // encode
-            StatPhase::wrap("Encode", [&] {
-                auto coder = lzss_coder_t(config().sub_config("coder")).encoder(output, lzss::UnreplacedLiterals<decltype(input_view), decltype(factors)>(input_view, factors));
-
-                coder.encode_text(input_view, factors);
-            });
-        }
-
-        inline std::unique_ptr<Decompressor> decompressor() const override
-        {
-            return Algorithm::instance<LZSSDecompressor<lzss_coder_t>>();
-        }
-    };
+            // the rounds find the factors out of order
+            factors.sort();
+        });
+
+        // statistics
+        IF_STATS({
+            lzss::FactorizationStats stats(factors, n);
+            stats.log();
+        })
+
+        // encode
+        StatPhase::wrap("Encode", [&]{
+            auto coder = lzss_coder_t(config().sub_config("coder")).encoder(
+                output, lzss::UnreplacedLiterals<decltype(view), decltype(factors)>(view, factors));
+
+            coder.encode_text(view, factors);
+        });
+    }
+
+    inline std::unique_ptr<Decompressor> decompressor() const override {
+        return Algorithm::instance<LZSSDecompressor<lzss_coder_t>>();
+    }
+};
 
 } // namespace tdc
@@ -12,7 +12,16 @@
 
 #include <tudocomp/compressors/lz_common/factorid_t.hpp>
 
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/DSManager.hpp>
+#include <tudocomp/ds/providers/DivSufSort.hpp>
+#include <tudocomp/ds/providers/ISAFromSA.hpp>
+#include <tudocomp/ds/providers/PhiAlgorithm.hpp>
+#include <tudocomp/ds/providers/PhiFromSA.hpp>
+#include <tudocomp/ds/providers/LCPFromPLCP.hpp>
+
 #include "lz78u/SuffixTree.hpp"
+#include "lz78u/LCPSuffixTree.hpp"
 
 #include "lz78u/pre_header.hpp"
 
@@ -89,11 +98,9 @@ namespace lz78u {
     };
 }
 
-template<typename strategy_t, typename ref_coder_t>
+template<typename strategy_t, typename ref_coder_t, typename ds_t = DSManager<DivSufSort, PhiFromSA, PhiAlgorithm, LCPFromPLCP, ISAFromSA>>
 class LZ78UCompressor: public CompressorAndDecompressor {
 private:
-    using node_type = lz78u::SuffixTree::node_type;
-
     using RefEncoder = typename ref_coder_t::Encoder;
     using RefDecoder = typename ref_coder_t::Decoder;
 
@@ -111,43 +118,43 @@ public:
         m.param("comp", "The factorization strategy.")
             .strategy<strategy_t>(TypeDesc("lz78u_strategy"));
         m.param("threshold", "the minimum factor length").primitive(3);
+        m.param("st",
+            "The suffix tree backing the factorization: "
+            "\"lcp\" for a tree on the suffix and LCP array, "
+            "\"cst\" for the compressed suffix tree of sdsl.").primitive("lcp");
+        m.param("ds", "The text data structure provider for \"lcp\".")
+            .strategy<ds_t>(ds::type(), Meta::Default<DSManager<DivSufSort, PhiFromSA, PhiAlgorithm, LCPFromPLCP, ISAFromSA>>());
         m.add_tag(tags::require_sentinel);
         return m;
     }
 
     using CompressorAndDecompressor::CompressorAndDecompressor;
 
-    virtual void compress(Input& input, Output& out) override {
-        StatPhase phase1("lz78u");
-        //std::cout << "START COMPRESS\n";
-        const len_t threshold = config().param("threshold").as_uint(); //factor threshold
-        phase1.log_stat("threshold", threshold);
-
-        auto iview = input.as_view();
-        MissingSentinelError::check(iview);
-
-        View T = iview;
+private:
+    template<typename st_t, typename isa_t>
+    inline void factorize(const st_t& ST, const isa_t& isa, View T, Output& out) {
+        using node_t = typename st_t::node_type;
 
-        lz78u::SuffixTree::cst_t backing_cst;
-        StatPhase::wrap("construct suffix tree", [&]{
-            // TODO: Specialize sdsl template for less alloc here
-            std::string bad_copy_1 = T.slice(0, T.size() - 1);
-            //std::cout << "text: " << vec_to_debug_string(bad_copy_1) << "\n";
+        const len_t threshold = config().param("threshold").as_uint(); //factor threshold
+        StatPhase::log("threshold", threshold);
 
-            construct_im(backing_cst, bad_copy_1, 1);
-        });
-        lz78u::SuffixTree ST(backing_cst);
+        size_t sigma = 0;
+        {
+            bool occurs[ULITERAL_MAX+1] = { false };
+            for(uliteral_t c : T) {
+                if(!occurs[c]) ++sigma;
+                occurs[c] = true;
+            }
+        }
 
-        const size_t max_z = T.size() * bits_for(ST.cst.csa.sigma) / bits_for(T.size());
-        phase1.log_stat("max z", max_z);
+        const size_t max_z = T.size() * bits_for(sigma) / bits_for(T.size());
+        StatPhase::log("max z", max_z);
 
-        sdsl::int_vector<> R(ST.internal_nodes,0,bits_for(max_z));
+        DynamicIntVector R(ST.internal_nodes, 0, bits_for(max_z));
 
         len_t pos = 0;
         len_t z = 0;
 
-        typedef lz78u::SuffixTree::node_type node_t;
-
         CompressionStrat strategy {
             config().sub_config("comp"),
             config().sub_config("coder"),
@@ -176,13 +183,12 @@ public:
                 for(len_t pos = begin; pos < end;) {
                     // similar to the normal LZ78U factorization, but does not introduce new factor ids
 
-                    const node_t leaf = ST.select_leaf(ST.cst.csa.isa[pos]);
-                    len_t d = 1;
+                    const node_t leaf = ST.select_leaf(isa[pos]);
                     node_t parent = ST.root;
-                    node_t node = ST.level_anc(leaf, d);
-                    while(!ST.cst.is_leaf(node) && R[ST.nid(node)] != 0) {
+                    node_t node = ST.child_towards(parent, leaf);
+                    while(!ST.is_leaf(node) && R[ST.nid(node)] != 0) {
                         parent = node;
-                        node = ST.level_anc(leaf, ++d);
+                        node = ST.child_towards(node, leaf);
                     } // not a good feature: We lost the factor ids of the leaves, since R only stores the IDs of internal nodes
                     const len_t depth = ST.str_depth(parent);
                     // if the largest factor is not large enough, we only store the current character and move one text position to the right
@@ -229,7 +235,7 @@ public:
 
         // Skip the trailing 0
         while(pos < T.size() - 1) {
-            const node_t l = ST.select_leaf(ST.cst.csa.isa[pos]);
+            const node_t l = ST.select_leaf(isa[pos]);
             const len_t leaflabel = pos;
 
             if(ST.parent(l) == ST.root || R[ST.nid(ST.parent(l))] != 0) {
@@ -248,14 +254,13 @@ public:
                 continue;
             }
 
-            len_t d = 1;
             node_t parent = ST.root;
-            node_t node = ST.level_anc(l, d);
+            node_t node = ST.child_towards(parent, l);
 
 
             while(R[ST.nid(node)] != 0) {
                 parent = node;
-                node = ST.level_anc(l, ++d);
+                node = ST.child_towards(node, l);
             }
             pos += ST.str_depth(parent);
 
@@ -275,6 +280,57 @@ public:
         }
     }
 
+public:
+    virtual void compress(Input& input, Output& out) override {
+        StatPhase phase1("lz78u");
+        //std::cout << "START COMPRESS\n";
+
+        auto iview = input.as_view();
+        MissingSentinelError::check(iview);
+
+        View T = iview;
+
+        const std::string st = config().param("st").as_string();
+        phase1.log_stat("st", st);
+
+        if(st == "cst") {
+            lz78u::SuffixTree::cst_t backing_cst;
+            StatPhase::wrap("construct suffix tree", [&]{
+                // TODO: Specialize sdsl template for less alloc here
+                std::string bad_copy_1 = T.slice(0, T.size() - 1);
+                //std::cout << "text: " << vec_to_debug_string(bad_copy_1) << "\n";
+
+                construct_im(backing_cst, bad_copy_1, 1);
+            });
+            lz78u::SuffixTree ST(backing_cst);
+            factorize(ST, ST.cst.csa.isa, T, out);
+        } else if(st == "lcp") {
+            ds_t ds(config().sub_config("ds"), T);
+            StatPhase::wrap("Construct Text DS", [&]{
+                ds.template construct<
+                    ds::SUFFIX_ARRAY,
+                    ds::LCP_ARRAY,
+                    ds::INVERSE_SUFFIX_ARRAY>();
+            });
+
+            std::unique_ptr<lz78u::LCPSuffixTree> ST;
+            StatPhase::wrap("construct suffix tree", [&]{
+                ST = std::make_unique<lz78u::LCPSuffixTree>(
+                    ds.template get<ds::SUFFIX_ARRAY>(),
+                    ds.template get<ds::LCP_ARRAY>());
+                StatPhase::log("internal nodes", ST->internal_nodes);
+            });
+
+            // only the inverse suffix array is needed from here on
+            ds.template discard<ds::SUFFIX_ARRAY>();
+            ds.template discard<ds::LCP_ARRAY>();
+
+            factorize(*ST, ds.template get<ds::INVERSE_SUFFIX_ARRAY>(), T, out);
+        } else {
+            throw std::invalid_argument("unknown suffix tree: " + st);
+        }
+    }
+
     virtual void decompress(Input& input, Output& output) override final {
         //std::cout << "START DECOMPRESS\n";
         DVLOG(2) << "[ decompress ]";
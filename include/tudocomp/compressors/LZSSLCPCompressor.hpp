@@ -70,10 +70,11 @@ public:
         StatPhase::wrap("Factorize", [&]{
             const len_t threshold = config().param("threshold").as_uint();
 
-            for(len_t i = 0; i+1 < text_length;) { // we omit T[text_length-1] since we assume that it is the \0 byte!
+            // the input does not need to end with a sentinel, its last
+            // character is handled like any other
+            for(len_t i = 0; i < text_length;) {
                 //get SA position for suffix i
                 const size_t& cur_pos = isa[i];
-			    DCHECK_NE(cur_pos,0); // isa[i] == 0 <=> T[i] = 0
 
 			    //compute naively PSV
                 //search "upwards" in LCP array
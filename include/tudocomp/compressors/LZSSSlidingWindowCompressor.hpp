@@ -1,12 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/Literal.hpp>
 #include <tudocomp/Range.hpp>
 #include <tudocomp/Tags.hpp>
 #include <tudocomp/util.hpp>
 
-#include <tudocomp/ds/RingBuffer.hpp>
+#include <tudocomp/ds/LCE.hpp>
 
 #include <tudocomp/compressors/lzss/Factor.hpp>
 #include <tudocomp/decompressors/LZSSDecompressor.hpp>
@@ -53,95 +56,73 @@ public:
             .encoder(output, NoLiterals());
 
         coder.factor_length_range(Range(m_threshold, 2 * m_window));
+        coder.max_reference_distance(m_window);
         coder.encode_header();
 
-        // allocate window and lookahead buffer
-        RingBuffer<uliteral_t> window(m_window), ahead(m_window);
+        // the window is followed by the lookahead buffer in a linear
+        // buffer, so matches can be extended by direct comparison (also
+        // into the lookahead buffer, for overlapping factors)
+        std::vector<uliteral_t> buf(
+            2 * m_window + std::max(m_window, size_t(1) << 16));
+        size_t wsize = 0; // the size of the window, which ends at cur
+        size_t cur = 0;   // the start of the lookahead buffer
+        size_t end = 0;   // the end of the lookahead buffer
 
         // open stream
         auto ins = input.as_stream();
         decltype(ins)::int_type c;
 
+        // fills the lookahead buffer
+        auto fill = [&](){
+            while(end - cur < m_window && (c = ins.get()) >= 0) {
+                if(end == buf.size()) {
+                    // move window and lookahead buffer to the front
+                    std::copy(buf.begin() + (cur - wsize), buf.begin() + end,
+                              buf.begin());
+                    end -= cur - wsize;
+                    cur = wsize;
+                }
+                buf[end++] = uliteral_t(c);
+            }
+        };
+
         // initialize lookahead buffer
-        while(!ahead.full() && (c = ins.get()) >= 0) {
-            ahead.push_back(uliteral_t(c));
-        }
+        fill();
 
         // factorize
         size_t i = 0; // all symbols before i have already been factorized
-        while(!ahead.empty()) {
-            auto ahead_dbg = ahead.dump();
-            auto window_dbg = window.dump();
+        while(cur < end) {
+            const uliteral_t* ahead = buf.data() + cur;
+            const uliteral_t* window = ahead - wsize;
 
             // look for longest prefix of ahead in window
             size_t flen = 1, fsrc = SIZE_MAX;
-            size_t pos = 0;
-
-            for(auto it = window.begin(); it != window.end(); it++) {
-                if(*it == ahead.peek_front()) {
-                    // at least one character matches, find factor length
-                    // by comparing additional characters
-                    size_t len = 1;
-
-                    auto it_window = it + 1;
-                    auto it_ahead = ahead.begin() + 1;
-
-                    while(it_window != window.end() &&
-                          it_ahead != ahead.end() &&
-                          *it_window == *it_ahead) {
-
-                        ++it_window;
-                        ++it_ahead;
-                        ++len;
-                    }
-
-                    if(it_window == window.end() && it_ahead != ahead.end()) {
-                        // we looked until the end of the window, but there
-                        // are more characters in the lookahead buffer
-                        // -> test for overlapping factor!
-                        auto it_overlap = ahead.begin();
-                        while(it_ahead != ahead.end() &&
-                            *it_overlap == *it_ahead) {
-
-                            ++it_overlap;
-                            ++it_ahead;
-                            ++len;
-                        }
-                    }
-
-                    // test if factor is currently the longest
-                    if(len > flen) {
-                        flen = len;
-                        fsrc = pos;
-                    }
+            for(size_t pos = 0; pos < wsize; pos++) {
+                const size_t len = lce::forward(window + pos, ahead, end - cur);
+
+                // test if factor is currently the longest
+                if(len > flen) {
+                    flen = len;
+                    fsrc = pos;
                 }
-                ++pos;
             }
 
             if(flen >= m_threshold) {
                 // factor
                 coder.encode_factor(lzss::Factor(
-                    i, i-window.size()+fsrc, flen));
+                    i, i-wsize+fsrc, flen));
             } else {
                 // unfactorized symbols
-                auto it = ahead.begin();
                 for(size_t k = 0; k < flen; k++) {
-                    coder.encode_literal(*it++);
+                    coder.encode_literal(ahead[k]);
                 }
             }
 
             // advance
             i += flen;
-
-            size_t advance = flen;
-            while(advance-- && !ahead.empty()) {
-                // move
-                window.push_back(ahead.pop_front());
-
-                if(!ins.eof() && (c = ins.get()) >= 0) {
-                    ahead.push_back(uliteral_t(c));
-                }
-            }
+            cur += flen;
+            wsize = std::min(m_window, wsize + flen);
+            fill();
         }
     }
 
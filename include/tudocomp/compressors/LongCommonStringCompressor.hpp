@@ -1,10 +1,20 @@
 #pragma once
 
+#include <cstring>
+#include <stdexcept>
 #include <unordered_set>
 #include <tudocomp/util/rollinghash/rabinkarphash.hpp>
 
 #include <tudocomp/Compressor.hpp>
+#include <tudocomp/ds/LCE.hpp>
 #include <tudocomp/decompressors/WrapDecompressor.hpp>
+#include <tudocomp/compressors/long_common/AnchorTable.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
 
 namespace tdc {
 
@@ -119,13 +129,236 @@ class LongCommonStringCompressor: public CompressorAndDecompressor {
         inline size_t dst_end() const { return m_dst_begin + m_size; }
     };
 
+    struct Anchor {
+        size_t end;
+        uint64_t fingerprint;
+    };
+
+    /// Polynomial fingerprints of windows of `b` bytes modulo 2^64, rolled
+    /// in several lanes at once so the lanes can be computed in parallel
+    /// by the CPU.
+    class LaneHash {
+        static constexpr uint64_t BASE = 0x100000001B3ULL;
+
+        const uint8_t* m_text;
+        size_t m_b;
+        uint64_t m_pow; // BASE^(b-1)
+        size_t m_shift; // selects the anchors by the topmost bits
+
+    public:
+        static constexpr size_t LANES = 8;
+
+        inline LaneHash(const uint8_t* text, size_t b, size_t sample_bits)
+            : m_text(text), m_b(b), m_pow(1), m_shift(64 - sample_bits) {
+            for(size_t i = 1; i < b; ++i) m_pow *= BASE;
+        }
+
+        /// The fingerprint of the window ending at `end`.
+        inline uint64_t hash(size_t end) const {
+            uint64_t h = 0;
+            for(size_t i = end - m_b; i < end; ++i) h = h * BASE + m_text[i];
+            return h;
+        }
+
+        /// Rolls the fingerprint of the window ending at `end` by one byte.
+        inline uint64_t roll(uint64_t h, size_t end) const {
+            return (h - m_text[end - m_b] * m_pow) * BASE + m_text[end];
+        }
+
+        /// Tests whether the fingerprint marks an anchor.
+        inline bool is_anchor(uint64_t h) const {
+            return m_shift == 64 || ((h * 0xC2B2AE3D27D4EB4FULL) >> m_shift) == 0;
+        }
+
+        /// Appends the anchors among the windows ending in `[begin, end)`
+        /// to `out`, in text order.
+        inline void anchors(size_t begin, size_t end, std::vector<Anchor>& out) const {
+            const size_t lane_size = (end - begin) / LANES;
+
+            if(lane_size > 0) {
+                uint64_t h[LANES];
+                size_t lane_begin[LANES];
+                std::vector<Anchor> found[LANES];
+                for(size_t l = 0; l < LANES; ++l) {
+                    lane_begin[l] = begin + l * lane_size;
+                    h[l] = hash(lane_begin[l]);
+                }
+
+                for(size_t i = 0;;) {
+                    for(size_t l = 0; l < LANES; ++l) {
+                        if(is_anchor(h[l])) {
+                            found[l].push_back(Anchor { lane_begin[l] + i, h[l] });
+                        }
+                    }
+                    if(++i == lane_size) break;
+                    for(size_t l = 0; l < LANES; ++l) {
+                        h[l] = roll(h[l], lane_begin[l] + i - 1);
+                    }
+                }
+
+                for(size_t l = 0; l < LANES; ++l) {
+                    out.insert(out.end(), found[l].begin(), found[l].end());
+                }
+            }
+
+            // the remainder
+            begin += LANES * lane_size;
+            if(begin < end) {
+                uint64_t x = hash(begin);
+                for(size_t i = begin;;) {
+                    if(is_anchor(x)) out.push_back(Anchor { i, x });
+                    if(++i == end) break;
+                    x = roll(x, i - 1);
+                }
+            }
+        }
+    };
+
+    template<typename coder_t>
+    inline void compress_anchored(View view, size_t b, coder_t& coder) {
+        const uint8_t* text = view.data();
+        const size_t n = view.size();
+
+        size_t sample_bits = 0;
+        while((size_t(2) << sample_bits) <= config().param("sample").as_uint()) {
+            ++sample_bits;
+        }
+        const LaneHash rk(text, b, sample_bits);
+
+        long_common::AnchorTable table(
+            size_t(config().param("table").as_uint()) << 20);
+
+        size_t threads = 1;
+#ifdef ENABLE_OPENMP
+        threads = omp_get_max_threads();
+#endif
+        std::vector<std::vector<Anchor>> chunk_anchors(threads);
+
+        // the candidate sources of each anchor of a segment, the ones of
+        // anchor i are at [candidate_offset[i], candidate_offset[i + 1])
+        std::vector<Anchor> anchors;
+        std::vector<size_t> candidate_offset;
+        std::vector<size_t> candidates;     // the end of the source window
+        std::vector<uint8_t> verified;      // whether the source matches
+
+        size_t last_output_offset = 0;
+        size_t num_anchors = 0;
+        size_t num_factors = 0;
+
+        // Windows are identified by their end position. The text is
+        // processed in segments, so only the anchors of one segment
+        // are held in memory at a time.
+        const size_t segment_size = size_t(16) << 20;
+        for(size_t segment = b; segment <= n; segment += segment_size) {
+            const size_t segment_end = std::min(n + 1, segment + segment_size);
+            const size_t chunk_size = idiv_ceil(segment_end - segment, threads);
+
+            // find the anchors of the segment in parallel
+            #ifdef ENABLE_OPENMP
+            #pragma omp parallel for schedule(static, 1)
+            #endif
+            for(size_t t = 0; t < threads; ++t) {
+                chunk_anchors[t].clear();
+                const size_t begin = segment + t * chunk_size;
+                const size_t end = std::min(segment_end, begin + chunk_size);
+                if(begin < end) rk.anchors(begin, end, chunk_anchors[t]);
+            }
+
+            // look up and store the anchors in text order
+            anchors.clear();
+            candidate_offset.clear();
+            candidates.clear();
+            for(auto& chunk : chunk_anchors) {
+                for(const Anchor& a : chunk) {
+                    anchors.push_back(a);
+                    candidate_offset.push_back(candidates.size());
+                    table.find(a.fingerprint, [&](size_t src_end) {
+                        candidates.push_back(src_end);
+                    });
+                    table.insert(a.fingerprint, a.end);
+                }
+            }
+            candidate_offset.push_back(candidates.size());
+            num_anchors += anchors.size();
+
+            // verify the candidates in bulk to rule out fingerprint collisions
+            verified.resize(candidates.size());
+            const ssize_t num_lookups = anchors.size();
+            #ifdef ENABLE_OPENMP
+            #pragma omp parallel for schedule(dynamic, 1024)
+            #endif
+            for(ssize_t i = 0; i < num_lookups; ++i) {
+                const size_t dst_begin = anchors[i].end - b;
+                for(size_t k = candidate_offset[i]; k < candidate_offset[i + 1]; ++k) {
+                    verified[k] = std::memcmp(
+                        text + candidates[k] - b, text + dst_begin, b) == 0;
+                }
+            }
+
+            // extend the verified matches and select the factors greedily
+            for(size_t i = 0; i < anchors.size(); ++i) {
+                const size_t dst_end = anchors[i].end;
+                const size_t dst_begin = dst_end - b;
+                if(dst_begin < last_output_offset) continue;
+
+                auto best = Match { 0, 0, 0 };
+                for(size_t k = candidate_offset[i]; k < candidate_offset[i + 1]; ++k) {
+                    if(!verified[k]) continue;
+
+                    const size_t src_end = candidates[k];
+                    const size_t src_begin = src_end - b;
+                    const size_t left = lce::backward(
+                        text + src_begin, text + dst_begin,
+                        std::min(src_begin, dst_begin - last_output_offset));
+                    const size_t right = lce::forward(
+                        text + src_end, text + dst_end, n - dst_end);
+
+                    const auto match = Match {
+                        src_begin - left, dst_begin - left, left + b + right };
+
+                    // prefer the closest of the longest matches
+                    if(match.size() > best.size() ||
+                       (match.size() == best.size() &&
+                        match.src_begin() > best.src_begin())) {
+                        best = match;
+                    }
+                }
+
+                if(best.size() != 0) {
+                    if(last_output_offset < best.dst_begin()) {
+                        coder.code_plain(view.slice(last_output_offset, best.dst_begin()));
+                    }
+                    coder.code_factor(best.dst_begin() - best.src_begin(), best.size());
+                    last_output_offset = best.dst_end();
+                    ++num_factors;
+                }
+            }
+        }
+
+        if(last_output_offset < n) {
+            coder.code_plain(view.slice(last_output_offset, n));
+        }
+
+        StatPhase::log("anchors", num_anchors);
+        StatPhase::log("factors", num_factors);
+    }
+
 public:
     inline static Meta meta() {
         Meta m(Compressor::type_desc(), "long_common_string");
         m.param("sparse_factor_coder").strategy<sparse_factor_coder_t>(
             TypeDesc("sparse_factor_coder"),
             Meta::Default<EscapingSparseFactorCoder>());
-        m.param("b").primitive(20);
+        m.param("b", "The length of the fingerprinted windows.").primitive(20);
+        m.param("mode",
+            "\"block\" fingerprints the blocks of length b, "
+            "\"anchor\" samples windows at content-defined anchors "
+            "into a table of bounded size.").primitive("block");
+        m.param("sample",
+            "In anchor mode, the average distance of anchors, "
+            "rounded down to a power of two.").primitive(32);
+        m.param("table",
+            "In anchor mode, the memory of the anchor table in MiB.").primitive(64);
         return m;
     }
 
@@ -135,6 +368,20 @@ public:
         size_t b = config().param("b").as_uint();
         CHECK_GT(b, 0U);
 
+        const std::string mode = config().param("mode").as_string();
+        if(mode == "anchor") {
+            auto view = input.as_view();
+            auto coder = typename sparse_factor_coder_t::Coder {
+                config().sub_config("sparse_factor_coder"),
+                output,
+            };
+
+            compress_anchored(view, b, coder);
+            return;
+        } else if(mode != "block") {
+            throw std::invalid_argument("unknown mode: " + mode);
+        }
+
         // TODO: Vary hash bit width?
         auto rolling_hash = rollinghash::KarpRabinHash<map_hash_t, uint8_t> {
             int(b),
@@ -215,13 +462,9 @@ public:
                     size_t const left_extend_begin
                         = std::max<size_t>(dst_left_border, dst_begin - (b - 1));
                     size_t const max_left_extend = dst_begin - left_extend_begin;
-                    left_extend = max_left_extend + b;
-                    for(size_t i = 0; i < max_left_extend; i++) {
-                        if ((src_begin - i == 0) || (view[dst_begin - i - 1] != view[src_begin - i - 1])) {
-                            left_extend = i + b;
-                            break;
-                        }
-                    }
+                    left_extend = b + lce::backward(
+                        view.data() + dst_begin, view.data() + src_begin,
+                        std::min(max_left_extend, src_begin));
                 } else {
                     if (dst_left_border < dst_end) {
                         left_extend = dst_end - dst_left_border;
@@ -235,13 +478,8 @@ public:
                 if (dst_left_border < dst_end) {
                     // Search forward
                     size_t const max_right_extend = view.size() - dst_end;
-                    right_extend = max_right_extend;
-                    for(size_t i = 0; i < max_right_extend; i++) {
-                        if (view[dst_end + i] != view[src_end + i]) {
-                            right_extend = i;
-                            break;
-                        }
-                    }
+                    right_extend = lce::forward(
+                        view.data() + dst_end, view.data() + src_end, max_right_extend);
                 }
 
                 size_t const src_match_begin = src_end - left_extend;
@@ -8,6 +8,8 @@
 
 #include <tudocomp/util/Counter.hpp>
 
+#include <tudocomp/compressors/esp/SLP.hpp>
+
 #include <tudocomp_stat/StatPhase.hpp>
 
 namespace tdc {
@@ -135,7 +137,7 @@ public:
                 // TODO: probably not optimal, but twice as fast as std::map
 
                 size_t i = 0;
-                while(i < n - 1) {
+                while(i + 1 < n) {
                     size_t j = next[i];
                     if(j >= n) break; // break if at end
 
@@ -162,7 +164,7 @@ public:
                 grammar.push_back(max);
 
                 size_t i = 0;
-                while(i < n - 1) {
+                while(i + 1 < n) {
                     size_t j = next[i];
                     if(j >= n) break; // break if at end
 
@@ -288,6 +290,18 @@ private:
         }
     }
 
+    template<typename decoder_t>
+    inline static sym_t decode_symbol(decoder_t& decoder, const Range& r) {
+        bool is_nonterminal = decoder.template decode<bool>(bit_r);
+        if(is_nonterminal) {
+            auto dec = decoder.template decode<sym_t>(r);
+            return sigma + dec;
+        } else {
+            auto dec = sym_t(decoder.template decode<uliteral_t>(literal_r));
+            return dec;
+        }
+    }
+
 public:
     virtual void decompress(Input& input, Output& output) override {
         // instantiate decoder
@@ -295,14 +309,7 @@ public:
 
         // lambda for decoding symbols
         auto decode_sym = [&](const Range& r) {
-            bool is_nonterminal = decoder.template decode<bool>(bit_r);
-            if(is_nonterminal) {
-                auto dec = decoder.template decode<sym_t>(r);
-                return sigma + dec;
-            } else {
-                auto dec = sym_t(decoder.template decode<uliteral_t>(literal_r));
-                return dec;
-            }
+            return decode_symbol(decoder, r);
         };
 
         // decode grammar
@@ -340,6 +347,52 @@ public:
         }
     }
 
+    virtual void extract(Input& input, Output& output,
+                         size_t offset, size_t length) override {
+        // instantiate decoder
+        typename coder_t::Decoder decoder(config().sub_config("coder"), input);
+
+        // decode grammar into an SLP, whose rule ids equal the symbols
+        static_assert(sigma == esp::SLP_CODING_ALPHABET_SIZE,
+            "terminals must be shared with the SLP");
+
+        esp::SLP slp { sigma };
+        {
+            auto num_rules = decoder.template decode<size_t>(len_r);
+            slp.resize(sigma + num_rules);
+
+            for(size_t i = 0; i < num_rules; i++) {
+                Range grammar_r(i);
+                sym_t l = decode_symbol(decoder, grammar_r);
+                sym_t r = decode_symbol(decoder, grammar_r);
+                slp.set(sigma + i, l, r);
+            }
+        }
+        slp.compute_lengths();
+
+        // walk the start rule and only derive the symbols covering the range
+        Range grammar_r(slp.size() - sigma);
+
+        auto ostream = output.as_stream();
+        auto emit = [&](size_t symbol) {
+            ostream << uliteral_t(symbol);
+        };
+
+        size_t pos = 0;
+        const size_t end = offset + std::min(length, SIZE_MAX - offset);
+        while(pos < end && !decoder.eof()) {
+            const sym_t x = decode_symbol(decoder, grammar_r);
+            const size_t x_len = slp.length(x);
+
+            if(pos + x_len > offset) {
+                const size_t from = std::max(offset, pos) - pos;
+                const size_t to = std::min(end, pos + x_len) - pos;
+                slp.derive(emit, x, from, to - from);
+            }
+            pos += x_len;
+        }
+    }
+
     inline std::unique_ptr<Decompressor> decompressor() const override {
         return std::make_unique<WrapDecompressor>(*this);
     }
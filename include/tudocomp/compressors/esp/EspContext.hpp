@@ -2,6 +2,7 @@
 
 #include <tudocomp_stat/StatPhase.hpp>
 
+#include <tudocomp/util/Trace.hpp>
 #include <tudocomp/util/View.hpp>
 
 #include <tudocomp/compressors/esp/SLP.hpp>
@@ -10,16 +11,164 @@
 #include <tudocomp/compressors/esp/meta_blocks.hpp>
 #include <tudocomp/compressors/esp/utils.hpp>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 namespace tdc {namespace esp {
     using dynamic_bit_vector_t = DynamicIntVector;
     using dynamic_bit_view_t = BitPackingVectorSlice<dynamic_t>; // TODO: Overhaul tudocomp view types
 
     template<typename ipd_t>
     class EspContext {
+        size_t m_threads;
+        size_t m_min_chunk_size;
+
+        inline size_t num_threads() const {
+            if (m_threads > 0) {
+                return m_threads;
+            }
+#ifdef ENABLE_OPENMP
+            return omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        // Returns the start positions of up to `max_chunks` chunks of `src`,
+        // followed by `src.size()`.
+        //
+        // Every chunk but the first starts at the beginning of a run of
+        // equal symbols. The sequential parse always starts a new metablock
+        // there, and the preceeding block can not have length 1, so
+        // BlockGrid never merges blocks across such a position.
+        // Hence each chunk can be split into blocks independently,
+        // and the concatenation equals the blocks of the whole string.
+        template<typename level_view_t>
+        inline static std::vector<size_t> chunk_bounds(
+            const level_view_t& src, size_t max_chunks) {
+
+            const size_t n = src.size();
+            std::vector<size_t> bounds { 0 };
+
+            for(size_t k = 1; k < max_chunks; k++) {
+                size_t p = std::max(n / max_chunks * k, bounds.back() + 2);
+                for(; p + 1 < n; p++) {
+                    if (src[p] == src[p + 1] && src[p - 1] != src[p]) {
+                        break;
+                    }
+                }
+                if (p + 1 >= n) {
+                    break; // no run left to split at
+                }
+                bounds.push_back(p);
+            }
+
+            bounds.push_back(n);
+            return bounds;
+        }
+
+        // Splits each chunk into blocks with a thread-local grammar, using
+        // up to `threads` threads, and merges those into `gr` in chunk order.
+        //
+        // Rules get merged in the order of their first occurrence,
+        // so the result is identical to the one of the sequential parse.
+        inline static void parallel_blocks(GrammarRules<ipd_t>& gr,
+                                           size_t alphabet_size,
+                                           const dynamic_bit_view_t& level_str,
+                                           const std::vector<size_t>& bounds,
+                                           dynamic_bit_vector_t& new_level_str,
+                                           size_t threads) {
+            struct Chunk {
+                GrammarRules<ipd_t> gr;
+                dynamic_bit_vector_t string;
+            };
+
+            const size_t num_chunks = bounds.size() - 1;
+            std::vector<std::unique_ptr<Chunk>> chunks(num_chunks);
+
+#ifdef ENABLE_OPENMP
+            #pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+#else
+            (void) threads;
+#endif
+            for(size_t c = 0; c < num_chunks; c++) {
+                Trace::Scope trace("ESP chunk");
+                trace.log("chunk", c);
+                trace.log("size", bounds[c + 1] - bounds[c]);
+
+                auto chunk_str = level_str.slice(bounds[c], bounds[c + 1]);
+
+                auto chunk = std::make_unique<Chunk>(Chunk {
+                    GrammarRules<ipd_t>(alphabet_size),
+                    dynamic_bit_vector_t(),
+                });
+
+                size_t width = bits_for(chunk_str.size() - 1);
+                chunk->string.width(width);
+                chunk->string.reserve(chunk_str.size() / 2 + 1, width);
+
+                auto block_grid = LevelContext(alphabet_size)
+                    .split_into_blocks(chunk_str);
+
+                dynamic_bit_view_t chunk_str_suffix = chunk_str;
+                block_grid.for_each_block_len([&](size_t block_len) {
+                    auto block = chunk_str_suffix.slice(0, block_len);
+                    chunk_str_suffix = chunk_str_suffix.slice(block_len);
+
+                    auto local_variable = chunk->gr.add(block) - (chunk->gr.initial_counter() - 1);
+
+                    chunk->string.push_back(local_variable);
+                });
+
+                chunks[c] = std::move(chunk);
+            }
+
+            for(auto& chunk : chunks) {
+                // Order the local rules by id, which is the order in which
+                // they occured in the chunk
+                const size_t local_count = chunk->gr.rules_count();
+                std::vector<std::array<size_t, 2>> local_rules(local_count);
+                chunk->gr.for_all([&](const auto& k, const auto& v) {
+                    const auto& key = k.as_view();
+                    local_rules[v - chunk->gr.initial_counter()] = {{ key[0], key[1] }};
+                });
+                gr.add_totals(chunk->gr.stats());
+                chunk->gr.clear();
+
+                // Ids >= alphabet_size refer to rules of this level
+                std::vector<size_t> local_to_global(local_count);
+                auto translate = [&](size_t sym) {
+                    return (sym < alphabet_size) ? sym
+                        : local_to_global[sym - alphabet_size] + alphabet_size;
+                };
+                for(size_t i = 0; i < local_count; i++) {
+                    auto& rule = local_rules[i];
+                    local_to_global[i] = gr.add_rule(translate(rule[0]), translate(rule[1]))
+                        - alphabet_size;
+                }
+
+                for(auto e : chunk->string) {
+                    new_level_str.push_back(local_to_global[size_t(e)]);
+                }
+
+                chunk.reset();
+            }
+        }
+
     public:
         IPDStats ipd_stats;
 
-        EspContext() = default;
+        /// Levels shorter than this are not worth splitting up.
+        static constexpr size_t DEFAULT_MIN_CHUNK_SIZE = 1ull << 16;
+
+        /// Creates a context that splits each grammar level into up to
+        /// `threads` chunks of at least `min_chunk_size` symbols, which are
+        /// processed in parallel. 0 threads means as many as OpenMP provides.
+        EspContext(size_t threads = 1,
+                   size_t min_chunk_size = DEFAULT_MIN_CHUNK_SIZE):
+            m_threads(threads),
+            m_min_chunk_size(std::max(min_chunk_size, size_t(2))) {}
 
         template<typename iterator_t>
         SLP generate_grammar(iterator_t&& begin, iterator_t&& end,
@@ -95,7 +244,18 @@ namespace tdc {namespace esp {
                 // Preallocate vector for the worst-case number of blocks
                 new_level_str.reserve(level_str.size() / 2 + 1, new_level_str_width);
 
-                {
+                const size_t max_chunks = std::min(num_threads(),
+                    level_str.size() / m_min_chunk_size);
+                const auto bounds = (max_chunks > 1)
+                    ? chunk_bounds(level_str, max_chunks)
+                    : std::vector<size_t> { 0, level_str.size() };
+                phase.log_stat("chunks", bounds.size() - 1);
+
+                if (bounds.size() > 2) {
+                    parallel_blocks(level.gr, level.alphabet_size,
+                                    level_str, bounds, new_level_str,
+                                    num_threads());
+                } else {
                     auto block_grid = LevelContext(level.alphabet_size)
                         .split_into_blocks(level_str);
 
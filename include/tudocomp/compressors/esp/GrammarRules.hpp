@@ -80,6 +80,42 @@ namespace tdc {namespace esp {
             }
         }
 
+        /// Inserts the rule `(l, r)` as-is, and returns its id.
+        ///
+        /// This is used to merge thread-local grammars into the grammar
+        /// of a level, where `l` may already be the id of a rule of this
+        /// level. Only the unique counters of the stats get updated, the
+        /// totals need to be carried over with `add_totals()`.
+        inline size_t add_rule(size_t l, size_t r) {
+            auto updater = [&](size_t& v) {
+                if (v == 0) {
+                    v = counter++;
+                }
+            };
+
+            Array<2> va;
+            va.m_data[0] = l;
+            va.m_data[1] = r;
+
+            auto old_counter = counter;
+            auto res = n2.access(va, updater) - 1;
+            if (counter > old_counter) {
+                m_stats.int_size2_unique++;
+                if (l >= m_initial_counter - 1) {
+                    // left side refers to a rule, so this is the
+                    // outer rule of a size 3 block
+                    m_stats.ext_size3_unique++;
+                }
+            }
+            return res;
+        }
+
+        inline void add_totals(const Stats& other) {
+            m_stats.ext_size2_total += other.ext_size2_total;
+            m_stats.ext_size3_total += other.ext_size3_total;
+            m_stats.int_size2_total += other.int_size2_total;
+        }
+
         inline size_t rules_count() const {
             return counter - m_initial_counter;
         }
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/compressors/esp/HashArray.hpp>
+
+namespace tdc {namespace esp {
+    /// IPD backed by a bit-packed hash index.
+    ///
+    /// A key pair is mapped to a single integer with Szudzik's pairing
+    /// function, which does not depend on a fixed width, but requires both
+    /// components to be less than 2^32. The keys are
+    /// stored once, in insertion order, in a bit-packed vector whose width
+    /// only grows with the largest symbol or rule id seen so far, which
+    /// keeps the tables of the lower levels small.
+    ///
+    /// The grammar assigns consecutive rule ids in insertion order, so the
+    /// id of a key follows from its position in that vector. The hash
+    /// table itself is an open addressing table of positions, bit-packed
+    /// to the width of the current amount of rules, and the table is
+    /// enumerated by walking the keys in order.
+    class PackedHashIPD: public Algorithm {
+    public:
+        inline static Meta meta() {
+            Meta m(TypeDesc("ipd"), "packed_hash",
+                "Open addressing hash table of bit-packed key positions");
+            return m;
+        };
+
+        using Algorithm::Algorithm;
+
+        template<size_t N, typename T, typename U>
+        class IPDMap {
+            static_assert(N == 2, "only pairs are supported");
+
+            static constexpr size_t MIN_TABLE_SIZE = 16;
+
+            // Keys in insertion order, the i-th key maps to m_first + i.
+            // The width grows along with the largest key.
+            DynamicIntVector m_keys;
+            U m_first = U(0);
+
+            // Hash table of positions in m_keys plus one, 0 marks an empty
+            // slot. The size is a power of two, and at most half of the
+            // slots are used.
+            DynamicIntVector m_slots;
+
+            static constexpr uint64_t MAX_COMPONENT = (1ULL << 32) - 1;
+
+            inline static uint64_t pair(uint64_t a, uint64_t b) {
+                if (a > MAX_COMPONENT || b > MAX_COMPONENT) {
+                    throw std::overflow_error(
+                        "packed_hash only supports ids less than 2^32");
+                }
+                return (a >= b) ? (a * a + a + b) : (b * b + a);
+            }
+
+            inline static Array<N, T> unpair(uint64_t z) {
+                // floor(sqrt(z)), corrected without squaring since the
+                // estimate may be off near 2^32
+                uint64_t s = std::min(uint64_t(std::sqrt(double(z))),
+                                      MAX_COMPONENT);
+                while (s > 0 && s > z / s) --s;
+                while (s < MAX_COMPONENT && s + 1 <= z / (s + 1)) ++s;
+
+                Array<N, T> key;
+                const uint64_t r = z - s * s;
+                if (r < s) {
+                    key.m_data[0] = r;
+                    key.m_data[1] = s;
+                } else {
+                    key.m_data[0] = s;
+                    key.m_data[1] = r - s;
+                }
+                return key;
+            }
+
+            inline static uint64_t hash(uint64_t k) {
+                k ^= k >> 33;
+                k *= 0xff51afd7ed558ccdULL;
+                k ^= k >> 33;
+                return k;
+            }
+
+            // Returns the slot that contains `k`, or the empty slot where
+            // it would be inserted.
+            inline size_t find_slot(uint64_t k) const {
+                const size_t mask = m_slots.size() - 1;
+                for (size_t i = hash(k) & mask;; i = (i + 1) & mask) {
+                    const size_t pos = m_slots[i];
+                    if (pos == 0 || uint64_t(m_keys[pos - 1]) == k) {
+                        return i;
+                    }
+                }
+            }
+
+            inline void grow_slots() {
+                const size_t size =
+                    std::max(size_t(MIN_TABLE_SIZE), 2 * m_slots.size());
+                m_slots = DynamicIntVector(size, 0, bits_for(size));
+                for (size_t i = 0; i < m_keys.size(); i++) {
+                    m_slots[find_slot(m_keys[i])] = i + 1;
+                }
+            }
+
+            inline void append_key(uint64_t k) {
+                const size_t w = bits_for(k);
+                if (w > m_keys.width()) {
+                    DynamicIntVector wider;
+                    wider.width(w);
+                    wider.reserve(m_keys.capacity(), w);
+                    for (size_t i = 0; i < m_keys.size(); i++) {
+                        wider.push_back(m_keys[i]);
+                    }
+                    m_keys = std::move(wider);
+                }
+                m_keys.push_back(k);
+            }
+
+        public:
+            inline IPDMap(size_t bucket_count, const Array<N, T>&) {
+                m_keys.width(1);
+                m_keys.reserve(bucket_count, 1);
+
+                const size_t size = std::max(size_t(MIN_TABLE_SIZE),
+                    size_t(zero_or_next_power_of_two(2 * bucket_count)));
+                m_slots = DynamicIntVector(size, 0, bits_for(size));
+            }
+
+            /// Looks up `key`. If it is missing, `updater` is called with
+            /// 0 and has to assign the next rule id, i.e., the ids of new
+            /// keys have to be consecutive. Throws `std::overflow_error` if
+            /// a component of `key` is 2^32 or larger.
+            template<typename Updater>
+            inline U access(const Array<N, T>& key, Updater updater) {
+                const uint64_t k = pair(key.m_data[0], key.m_data[1]);
+
+                const size_t slot = find_slot(k);
+                const size_t pos = m_slots[slot];
+                if (pos != 0) {
+                    U val = m_first + U(pos - 1);
+                    U copy = val;
+                    updater(copy);
+                    DCHECK_EQ(copy, val) << "stored values can not be changed";
+                    return val;
+                }
+
+                U val = U(0);
+                updater(val);
+                if (val != U(0)) {
+                    if (m_keys.size() == 0) {
+                        m_first = val;
+                    }
+                    DCHECK_EQ(val, m_first + U(m_keys.size()))
+                        << "rule ids have to be assigned consecutively";
+
+                    append_key(k);
+                    if (2 * m_keys.size() > m_slots.size()) {
+                        grow_slots();
+                    } else {
+                        m_slots[slot] = m_keys.size();
+                    }
+                }
+                return val;
+            }
+
+            inline size_t size() const {
+                return m_keys.size();
+            }
+
+            /// Calls `f(key, value)` for all entries in insertion order.
+            template<typename F>
+            void for_all(F f) const {
+                for (size_t i = 0; i < m_keys.size(); i++) {
+                    f(unpair(m_keys[i]), m_first + U(i));
+                }
+            }
+        };
+    };
+}}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <array>
+#include <vector>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/util/bits.hpp>
 
 namespace tdc {namespace esp {
 
@@ -15,6 +18,8 @@ namespace tdc {namespace esp {
         // for better cache locality
         DynamicIntVector m_dl;
         DynamicIntVector m_dr;
+        // expansion lengths of the rules, see compute_lengths()
+        DynamicIntVector m_len;
         size_t m_alphabet_size = 0;
         size_t m_root_rule = 0;
         bool m_is_empty = true;
@@ -41,6 +46,9 @@ namespace tdc {namespace esp {
 
             DCHECK_EQ(m_dl.width(), width);
             DCHECK_EQ(m_dr.width(), width);
+
+            // the rules might change, so the lengths are no longer valid
+            m_len = DynamicIntVector();
         }
 
         /*
@@ -103,6 +111,121 @@ namespace tdc {namespace esp {
             }
         }
 
+        /// Computes the expansion length of every rule, which is
+        /// needed for random access via \ref extract.
+        ///
+        /// Rules are not required to be ordered by dependency,
+        /// so this does a depth-first traversal with an explicit stack.
+        inline void compute_lengths() {
+            std::vector<size_t> len(size(), 0);
+            for (size_t i = 0; i < std::min(m_alphabet_size, size()); i++) {
+                len[i] = 1;
+            }
+
+            std::vector<size_t> stack;
+            size_t max_len = 1;
+            for (size_t rule = m_alphabet_size; rule < size(); rule++) {
+                if (len[rule] != 0) continue;
+
+                stack.push_back(rule);
+                while (!stack.empty()) {
+                    const size_t r = stack.back();
+                    const size_t l_len = len[get_l(r)];
+                    const size_t r_len = len[get_r(r)];
+
+                    if (l_len != 0 && r_len != 0) {
+                        len[r] = l_len + r_len;
+                        max_len = std::max(max_len, len[r]);
+                        stack.pop_back();
+                    } else {
+                        if (l_len == 0) stack.push_back(get_l(r));
+                        if (r_len == 0) stack.push_back(get_r(r));
+                    }
+                }
+            }
+
+            m_len = DynamicIntVector();
+            m_len.width(bits_for(max_len));
+            m_len.reserve(len.size(), bits_for(max_len));
+            for (size_t l : len) {
+                m_len.push_back(l);
+            }
+        }
+
+        inline bool has_lengths() const {
+            return m_len.size() == size();
+        }
+
+        /// Returns the length of the text derived from the given rule.
+        ///
+        /// Requires a prior call to \ref compute_lengths.
+        inline size_t length(size_t rule) const {
+            DCHECK(has_lengths());
+            return m_len[rule];
+        }
+
+        /// Returns the length of the text derived from the root rule.
+        ///
+        /// Requires a prior call to \ref compute_lengths.
+        inline size_t text_length() const {
+            return m_is_empty ? 0 : length(m_root_rule);
+        }
+
+        /// Derives the range of the given length starting at the given
+        /// offset from the text of the given rule, descending only into the
+        /// rules covering that range.
+        ///
+        /// The range must lie within the derived text.
+        template<typename F>
+        inline void derive(F f, size_t rule, size_t offset, size_t length) const {
+            DCHECK_LE(offset + length, this->length(rule));
+
+            while (length > 0) {
+                if (rule < m_alphabet_size) {
+                    f(rule);
+                    return;
+                }
+
+                const size_t l = get_l(rule);
+                const size_t l_len = this->length(l);
+                if (offset >= l_len) {
+                    // the range lies within the right child only
+                    offset -= l_len;
+                } else if (offset + length <= l_len) {
+                    // the range lies within the left child only
+                    rule = l;
+                    continue;
+                } else {
+                    const size_t split = l_len - offset;
+                    derive(f, l, offset, split);
+                    offset = 0;
+                    length -= split;
+                }
+                rule = get_r(rule);
+            }
+        }
+
+        /// Derives the given range of the text, which is clamped to the
+        /// end of the text.
+        ///
+        /// Requires a prior call to \ref compute_lengths.
+        template<typename F>
+        inline void extract(F f, size_t offset, size_t length) const {
+            const size_t n = text_length();
+            if (offset < n) {
+                derive(f, m_root_rule, offset, std::min(length, n - offset));
+            }
+        }
+
+        inline std::ostream& extract_text(std::ostream& o,
+                                          size_t offset,
+                                          size_t length) const {
+            extract([&](size_t symbol) {
+                o << char(symbol);
+            }, offset, length);
+            return o;
+        }
+
         inline std::ostream& derive_text(std::ostream& o) const {
             derive([&](size_t symbol) {
                 o << char(symbol);
@@ -4,6 +4,7 @@
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/def.hpp>
 #include <tudocomp/util.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
 
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
 #include <tudocomp/compressors/lcpcomp/lcpcomp.hpp>
@@ -54,9 +55,11 @@ public:
         std::vector<len_compact_t>* cand = new std::vector<len_compact_t>[cand_length];
 
         StatPhase::wrap("Fill candidates", [&]{
+            bulk::Reader lcp_reader(lcp, 1);
             for(size_t i = 1; i < sa.size(); ++i) {
-                if(lcp[i] < threshold) continue;
-                cand[lcp[i]-threshold].push_back(i);
+                const size_t l = lcp_reader.next();
+                if(l < threshold) continue;
+                cand[l-threshold].push_back(i);
             }
 
             StatPhase::log("entries", [&] () {
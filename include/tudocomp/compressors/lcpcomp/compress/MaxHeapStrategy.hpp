@@ -3,6 +3,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/ArrayMaxHeap.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
 
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
 #include <tudocomp/compressors/lcpcomp/lcpcomp.hpp>
@@ -50,14 +51,15 @@ public:
         auto heap = StatPhase::wrap("Construct MaxLCPHeap", [&]{
             // Count relevant LCP entries
             size_t heap_size = 0;
-            for(size_t i = 1; i < lcp.size(); i++) {
-                if(lcp[i] >= threshold) ++heap_size;
+            for(uint64_t l : bulk::Reader(lcp, 1)) {
+                if(l >= threshold) ++heap_size;
             }
 
             // Construct heap
             ArrayMaxHeap<decltype(lcp)> heap(lcp, lcp.size(), heap_size);
+            bulk::Reader lcp_reader(lcp, 1);
             for(size_t i = 1; i < lcp.size(); i++) {
-                if(lcp[i] >= threshold) heap.insert(i);
+                if(lcp_reader.next() >= threshold) heap.insert(i);
             }
 
             StatPhase::log("entries", heap.size());
@@ -13,6 +13,7 @@
 #include <tudocomp/ds/IntVector.hpp>
 
 #include <tudocomp/Algorithm.hpp>
+#include <tudocomp/Tags.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
@@ -367,6 +368,7 @@ public:
 
     inline static Meta meta() {
         Meta m(comp_strategy_type(), "plcp", "Uses the PLCP array");
+        m.add_tag(tags::require_sentinel); // phi_algorithm relies on it
         return m;
     }
 
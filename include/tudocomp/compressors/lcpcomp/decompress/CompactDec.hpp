@@ -32,13 +32,14 @@ private:
     IF_STATS(len_t m_current_chain);
 
     IntVector<uliteral_t> m_buffer;
+    BitVector m_decoded; // the text may contain 0 bytes
 
     inline void decode_literal_at(len_t pos, uliteral_t c) {
 		IF_STATS(++m_current_chain);
         IF_STATS(m_longest_chain = std::max(m_longest_chain, m_current_chain));
 
         m_buffer[pos] = c;
-		DCHECK(c != 0 || pos == m_buffer.size()-1); // we assume that the text to restore does not contain a NULL-byte but at its very end
+        m_decoded[pos] = 1;
 
         if(m_fwd[pos] != nullptr) {
             const len_compact_t*const& bucket = m_fwd[pos];
@@ -63,17 +64,15 @@ public:
         }
     }
     inline CompactDec(Config&& cfg)
-        : Algorithm(std::move(cfg)), m_cursor(0) {
+        : Algorithm(std::move(cfg)), m_fwd(nullptr), m_cursor(0) {
 
         IF_STATS(m_longest_chain = 0);
         IF_STATS(m_current_chain = 0);
     }
 
     inline void initialize(size_t n) {
-        if(tdc_unlikely(n == 0)) throw std::runtime_error(
-            "no text length provided");
-
         m_buffer.resize(n, 0);
+        m_decoded = BitVector(n, 0);
         m_fwd = new len_compact_t*[n];
         std::fill(m_fwd,m_fwd+n,nullptr);
     }
@@ -85,7 +84,7 @@ public:
     inline void decode_factor(len_t pos, len_t num) {
         for(len_t i = 0; i < num; i++) {
             len_t src = pos+i;
-            if(m_buffer[src]) {
+            if(m_decoded[src]) {
                 decode_literal_at(m_cursor, m_buffer[src]);
             } else {
                 len_compact_t*& bucket = m_fwd[src];
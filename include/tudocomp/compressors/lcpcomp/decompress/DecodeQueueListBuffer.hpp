@@ -57,9 +57,6 @@ public:
     }
 
     inline void initialize(size_t n) {
-        if(tdc_unlikely(n == 0)) throw std::runtime_error(
-            "no text length provided");
-
         m_buffer.resize(n, 0);
         m_fwd.resize(n, std::vector<len_compact_t>());
         m_decoded = BitVector(n, 0);
@@ -125,9 +125,6 @@ namespace tdc {
             {}
 
             inline void initialize(size_t n) {
-                if(tdc_unlikely(n == 0)) throw std::runtime_error(
-                    "no text length provided");
-
                 m_buffer = IntVector<uliteral_t>(n);
                 m_sources = SourceVector(n);
             }
@@ -136,8 +133,6 @@ namespace tdc {
                 m_buffer[m_cursor] = c;
                 m_sources[m_cursor] = m_cursor;
                 m_cursor++;
-
-                DCHECK(c != 0 || m_cursor == m_buffer.size()); // we assume that the text to restore does not contain a NULL-byte but at its very end
             }
 
             inline void decode_factor(const len_t source_position, const len_t factor_length) {
@@ -230,9 +230,6 @@ namespace tdc {
                 {}
 
                 inline void initialize(size_t n) {
-                    if(tdc_unlikely(n == 0)) throw std::runtime_error(
-                        "no text length provided");
-
                     m_buffer = IntVector<uliteral_t>(n);
                 }
 
@@ -246,9 +243,6 @@ namespace tdc {
 
                     m_decode_literal_factor.len++;
                     m_cursor++;
-
-                    // we assume that the text to restore does not contain a NULL-byte but at its very end
-                    DCHECK(c != 0 || m_cursor == m_buffer.size());
                 }
 
                 inline void decode_factor(const len_t source_position, len_t factor_length) {
@@ -396,11 +390,6 @@ namespace tdc {
                                             std::next(m_buffer.cbegin(), request.source + length),
                                             std::next(m_buffer.begin(), request.target)
                                     );
-
-                                    // make sure we only copy initialised data
-                                    for (len_t j = request.source; j < request.source + length; ++j) {
-                                        DCHECK(m_buffer[j]);
-                                    }
                                 }
 
                             } else {
@@ -32,6 +32,7 @@ namespace lcpcomp {
 	 */
 	class EagerScanDec {
 		IntVector<uliteral_t>& m_buffer;
+		BitVector& m_decoded;
 		const sdsl::bit_vector m_bv;
 		const sdsl::bit_vector::rank_1_type m_rank;
 		const len_t m_empty_entries;
@@ -41,19 +42,20 @@ namespace lcpcomp {
 		IF_STATS(len_t m_current_chain = 0);
 
 		public:
-		EagerScanDec(IntVector<uliteral_t>& buffer)
+		EagerScanDec(IntVector<uliteral_t>& buffer, BitVector& decoded)
 			: m_buffer { buffer }
-			, m_bv ( [&buffer] () -> sdsl::bit_vector {
-				sdsl::bit_vector bv { buffer.size(),0 };
-				for(len_t i = 0; i < buffer.size(); ++i) {
-					if(buffer[i]) continue;
+			, m_decoded { decoded }
+			, m_bv ( [&decoded] () -> sdsl::bit_vector {
+				sdsl::bit_vector bv { decoded.size(),0 };
+				for(len_t i = 0; i < decoded.size(); ++i) {
+					if(decoded[i]) continue;
 					bv[i] = 1;
 				}
 				return bv;
 			}() )
 			, m_rank { &m_bv }
 			//, m_empty_entries { static_cast<len_t>( buffer.size()) }
-			, m_empty_entries { static_cast<len_t>(std::count_if(buffer.cbegin(), buffer.cend(), [] (const uliteral_t& i) { return i == 0; })) }
+			, m_empty_entries { static_cast<len_t>(m_rank.rank(m_bv.size())) }
 			, m_fwd { new len_compact_t*[m_empty_entries+1] }
 		{
         std::fill(m_fwd,m_fwd+m_empty_entries,nullptr);
@@ -74,7 +76,7 @@ namespace lcpcomp {
 				const len_compact_t& source_position = m_source_pos[j];
 				const len_compact_t& factor_length = m_length[j];
 				for(len_t i = 0; i < factor_length; ++i) {
-					if(m_buffer[source_position+i]) {
+					if(m_decoded[source_position+i]) {
 						decode_literal_at(target_position+i, m_buffer[source_position+i]);
 					} else {
 						DCHECK_EQ(m_bv[source_position+i],1U);
@@ -108,9 +110,9 @@ namespace lcpcomp {
 		IF_STATS(++m_current_chain);
         IF_STATS(m_longest_chain = std::max(m_longest_chain, m_current_chain));
 
-		DCHECK(m_buffer[pos] == 0 || m_buffer[pos] == c) << "would write " << c << " to mbuffer[" << pos << "] = " << m_buffer[pos];
+		DCHECK(!m_decoded[pos] || m_buffer[pos] == c) << "would write " << c << " to mbuffer[" << pos << "] = " << m_buffer[pos];
         m_buffer[pos] = c;
-		DCHECK(c != 0 || pos == m_buffer.size()-1); // we assume that the text to restore does not contain a NULL-byte but at its very end
+        m_decoded[pos] = 1;
 
 		if(m_bv[pos] == 1) {
 			const len_t rankpos = rank(pos);
@@ -169,7 +171,7 @@ public:
     }
     inline void decode_eagerly() {
         EagerScanDec* decoder = StatPhase::wrap("Initialize Bit Vector", [&]{
-            return new EagerScanDec(m_buffer);
+            return new EagerScanDec(m_buffer, m_decoded);
         });
 
         decoder->decode(m_target_pos, m_source_pos, m_length);
@@ -188,8 +190,10 @@ private:
             const len_compact_t& source_position = m_source_pos[j];
             const len_compact_t& factor_length = m_length[j];
             for(len_t i = 0; i < factor_length; ++i) {
-				//DCHECK(m_buffer[source_position+i] == 0 && m_buffer[target_position+i] == 0);
-				m_buffer[target_position+i] = m_buffer[source_position+i];
+				if(m_decoded[source_position+i]) {
+					m_buffer[target_position+i] = m_buffer[source_position+i];
+					m_decoded[target_position+i] = 1;
+				}
             }
         }
     }
@@ -198,6 +202,7 @@ private:
     len_t m_cursor;
 
 	IntVector<uliteral_t> m_buffer;
+	BitVector m_decoded; // the text may contain 0 bytes
 
     //storing factors
     std::vector<len_compact_t> m_target_pos;
@@ -214,23 +219,22 @@ public:
 	{ }
 
     inline void initialize(size_t n) {
-        if(tdc_unlikely(n == 0)) throw std::runtime_error(
-            "no text length provided");
-
         m_buffer.resize(n, 0);
+        m_decoded = BitVector(n, 0);
     }
 
     inline void decode_literal(uliteral_t c) {
+        m_decoded[m_cursor] = 1;
         m_buffer[m_cursor++] = c;
-		DCHECK(c != 0 || m_cursor == m_buffer.size()); // we assume that the text to restore does not contain a NULL-byte but at its very end
     }
 
     inline void decode_factor(const len_t source_position, const len_t factor_length) {
         bool factor_stored = false;
         for(len_t i = 0; i < factor_length; ++i) {
             const len_t src_pos = source_position+i;
-            if(m_buffer[src_pos]) {
+            if(m_decoded[src_pos]) {
                 m_buffer[m_cursor] = m_buffer[src_pos];
+                m_decoded[m_cursor] = 1;
             }
             else if(factor_stored == false) {
                 factor_stored = true;
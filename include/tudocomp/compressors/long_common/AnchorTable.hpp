@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tdc {
+namespace long_common {
+
+/// A fingerprint table of bounded size that maps fingerprints to the
+/// positions at which they were last seen.
+///
+/// The table is set-associative: a fingerprint can only be stored in one of
+/// the WAYS slots of its bucket. If all of them are occupied, the oldest
+/// entry is replaced, so the memory stays fixed no matter how large the
+/// input is and recent positions are preferred.
+class AnchorTable {
+public:
+    static constexpr size_t WAYS = 4;
+
+    struct Entry {
+        uint64_t fingerprint;
+        uint64_t end; // 0 for empty slots, positions are always positive
+    };
+
+private:
+    std::vector<Entry> m_entries;
+    size_t m_bucket_bits;
+
+    inline Entry* bucket(uint64_t fingerprint) {
+        // the shift would be undefined for a single bucket
+        const uint64_t mixed = fingerprint * 0x9E3779B97F4A7C15ULL;
+        return m_entries.data() +
+            (m_bucket_bits ? WAYS * (mixed >> (64 - m_bucket_bits)) : 0);
+    }
+
+    inline const Entry* bucket(uint64_t fingerprint) const {
+        return const_cast<AnchorTable*>(this)->bucket(fingerprint);
+    }
+
+public:
+    /// Creates a table that takes up at most `max_bytes` bytes of memory,
+    /// but has at least one bucket.
+    inline AnchorTable(size_t max_bytes) {
+        size_t bits = 0;
+        while((size_t(WAYS * sizeof(Entry)) << (bits + 1)) <= max_bytes && bits < 48) {
+            ++bits;
+        }
+
+        m_entries.resize(WAYS << bits, Entry { 0, 0 });
+        m_bucket_bits = bits;
+    }
+
+    /// Stores the position `end` for the fingerprint, replacing an older
+    /// position of the same fingerprint or the oldest entry in the bucket.
+    inline void insert(uint64_t fingerprint, uint64_t end) {
+        Entry* b = bucket(fingerprint);
+        Entry* victim = b;
+        for(size_t i = 0; i < WAYS; ++i) {
+            if(b[i].end == 0 || b[i].fingerprint == fingerprint) {
+                victim = b + i;
+                break;
+            } else if(b[i].end < victim->end) {
+                victim = b + i;
+            }
+        }
+        *victim = Entry { fingerprint, end };
+    }
+
+    /// Calls `visit(end)` for each position stored for the fingerprint.
+    template<typename visit_t>
+    inline void find(uint64_t fingerprint, visit_t visit) const {
+        const Entry* b = bucket(fingerprint);
+        for(size_t i = 0; i < WAYS; ++i) {
+            if(b[i].end != 0 && b[i].fingerprint == fingerprint) visit(b[i].end);
+        }
+    }
+};
+
+}} //ns
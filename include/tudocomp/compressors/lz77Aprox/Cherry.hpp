@@ -1,83 +1,30 @@
 #pragma once
 
 #include <tudocomp/def.hpp>
-#include <tudocomp/compressors/lz77Aprox/AproxFactor.hpp>
-#include <vector>
-namespace tdc{
 
-class Cherry {
-public:
-     /*  Left and right Vector which holds information about the chains
-     *  of the cherry
-     */
-    mutable long long l :64;
-    mutable long long r :64;
+namespace tdc {
+namespace lz77Aprox {
 
-    mutable unsigned int status : 3;
-        
-    len_compact_t position;
-        
-    mutable len_compact_t length;
-
-
-    //which children are found
-   mutable bool leftfound, rightfound;
-    Cherry(len_t pos, len_t len, len_t fl){
-        position = pos;
-        length=len;
-        status = fl;
-
-        l=0;
-        r=0;
-        leftfound=false;
-        rightfound=false;
-    }
-
-    inline Cherry(){
-        //undefined!
-    }
-    
-    //return the rightchild and turns this into leftchild
-    // this is const cause status and length are mutable
-    inline Cherry split() const {
-        Cherry rightchild = Cherry(position + length/2,length/2,0);
-        rightchild.r=r;
-        r=0;
-
-        rightchild.status=status;
-        //change this
-
-        length=length/2;
-        status=0;
-        //return
-
-        return rightchild;
-    }
-    //this is the only non-const func cause we change the position
-    inline void only_leftfound(){
-        //add a 1 at the right pos
-        l=l+length/2;
-        position = position +length/2;
-        
-        length=length/2;
-
-        reset_found();
-    }
-    inline void only_rightfound() const {
-        r=r+length/2;
-        length=length/2;
-        reset_found();
+/// A block of the text whose two halves (the children) are tested for an
+/// earlier occurrence in the next round.
+///
+/// The length is always a power of two. Only the last block of the text
+/// may reach beyond its end.
+struct Cherry {
+    len_t position;
+    len_t length;
 
+    inline len_t half() const {
+        return length / 2;
     }
-    inline void reset_found()const{
-        rightfound=false;
-        leftfound=false;
 
+    inline len_t left() const {
+        return position;
     }
 
-    bool operator< (Cherry x  )const{
-        return this->position< x.position;
+    inline len_t right() const {
+        return position + half();
     }
-}__attribute__((__packed__));
+};
 
-}
\ No newline at end of file
+}} //ns
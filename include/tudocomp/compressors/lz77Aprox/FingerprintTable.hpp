@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <tudocomp/def.hpp>
+
+namespace tdc {
+namespace lz77Aprox {
+
+/// An open addressing hash table with linear probing that maps
+/// fingerprints to integer values.
+///
+/// Different strings may share a fingerprint, so the table can hold the
+/// same key several times and leaves it to the caller to tell the values
+/// apart. The memory is kept when the table is cleared, so it can be
+/// reused across rounds without allocations.
+class FingerprintTable {
+    static constexpr len_t EMPTY = INDEX_MAX;
+
+    std::vector<uint64_t> m_keys;
+    std::vector<len_compact_t> m_values;
+    size_t m_mask;
+
+    inline size_t slot(uint64_t key) const {
+        return size_t((key * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+    }
+
+public:
+    inline FingerprintTable() : m_mask(0) {
+    }
+
+    /// Clears the table and prepares it for up to `n` entries.
+    inline void reset(size_t n) {
+        size_t cap = 2;
+        while(cap < 2 * n) cap *= 2;
+
+        m_keys.resize(cap);
+        m_values.resize(cap);
+        std::fill(m_values.begin(), m_values.begin() + cap, len_t(EMPTY));
+        m_mask = cap - 1;
+    }
+
+    /// Returns a value stored for `key` for which `equal(value)` holds,
+    /// or inserts and returns `value` if there is none.
+    template<typename equal_t>
+    inline len_t insert(uint64_t key, len_t value, equal_t equal) {
+        for(size_t i = slot(key);; i = (i + 1) & m_mask) {
+            if(m_values[i] == EMPTY) {
+                m_keys[i] = key;
+                m_values[i] = value;
+                return value;
+            } else if(m_keys[i] == key && equal(m_values[i])) {
+                return m_values[i];
+            }
+        }
+    }
+
+    /// Calls `visit(value)` for each value stored for `key`.
+    template<typename visit_t>
+    inline void find(uint64_t key, visit_t visit) const {
+        for(size_t i = slot(key); m_values[i] != EMPTY; i = (i + 1) & m_mask) {
+            if(m_keys[i] == key) visit(m_values[i]);
+        }
+    }
+};
+
+}} //ns
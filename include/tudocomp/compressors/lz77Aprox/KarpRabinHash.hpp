@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+#include <tudocomp/def.hpp>
+
+namespace tdc {
+namespace lz77Aprox {
+
+/// Karp-Rabin fingerprints of fixed-length substrings modulo the
+/// Mersenne prime 2^61-1, which can be rolled over the text.
+class KarpRabinHash {
+public:
+    static constexpr uint64_t MOD = (1ULL << 61) - 1;
+    static constexpr uint64_t BASE = 0x1A2B3C4D5E6F7ULL % MOD;
+
+private:
+    len_t m_length;
+    uint64_t m_pow; // BASE^(m_length-1)
+
+    inline static uint64_t mul(uint64_t a, uint64_t b) {
+        const __uint128_t p = __uint128_t(a) * b;
+        uint64_t r = uint64_t(p & MOD) + uint64_t(p >> 61);
+        return (r >= MOD) ? r - MOD : r;
+    }
+
+    inline static uint64_t add(uint64_t a, uint64_t b) {
+        const uint64_t r = a + b;
+        return (r >= MOD) ? r - MOD : r;
+    }
+
+public:
+    /// Creates fingerprints for substrings of the given length.
+    inline KarpRabinHash(len_t length) : m_length(length), m_pow(1) {
+        for(len_t i = 1; i < length; ++i) m_pow = mul(m_pow, BASE);
+    }
+
+    inline len_t length() const {
+        return m_length;
+    }
+
+    /// Computes the fingerprint of the substring starting at `s`.
+    inline uint64_t hash(const uliteral_t* s) const {
+        uint64_t h = 0;
+        for(len_t i = 0; i < m_length; ++i) h = add(mul(h, BASE), s[i]);
+        return h;
+    }
+
+    /// Rolls the fingerprint `h` of a substring one position to the right,
+    /// dropping the character `out` and appending the character `in`.
+    inline uint64_t roll(uint64_t h, uliteral_t out, uliteral_t in) const {
+        h = add(h, MOD - mul(out, m_pow));
+        return add(mul(h, BASE), in);
+    }
+};
+
+}} //ns
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <vector>
+
+#include <tudocomp/def.hpp>
+#include <glog/logging.h>
+
+namespace tdc {
+namespace lz78u {
+
+/**
+ * An implicit suffix tree built on top of the suffix and LCP array.
+ *
+ * The internal nodes are the LCP intervals of the text, which are
+ * enumerated with a single stack-based scan over the LCP array. Only the
+ * navigation needed by the LZ78U factorization is supported: selecting a
+ * leaf by its suffix array position, the parent and string depth of a node,
+ * and stepping from a node to its child on the path to a given leaf, which
+ * replaces the level ancestor queries of the sdsl suffix tree by a binary
+ * search over the child intervals.
+ *
+ * A node is represented by an integer: the internal nodes are numbered
+ * from 0 (the root) to `internal_nodes - 1`, and the leaf of the suffix
+ * array position `i` is `internal_nodes + i`.
+ */
+class LCPSuffixTree {
+public:
+    using node_type = len_t;
+
+private:
+    // internal nodes
+    std::vector<len_compact_t> m_depth;  //! string depth
+    std::vector<len_compact_t> m_lb;     //! left bound of the LCP interval
+    std::vector<len_compact_t> m_parent; //! parent node
+    std::vector<len_compact_t> m_first;  //! children are m_children[m_first[v], m_first[v+1])
+
+    std::vector<len_compact_t> m_children;    //! children in lexicographic order
+    std::vector<len_compact_t> m_leaf_parent; //! the parent of each leaf
+
+    inline len_t lb(node_type v) const {
+        return is_leaf(v) ? v - internal_nodes : m_lb[v];
+    }
+
+public:
+    const node_type root = 0; //! the root node of the suffix tree
+    len_t internal_nodes;     //! number of internal nodes
+
+    /**
+     * Builds the tree from the suffix array `sa` and the LCP array `lcp`
+     * of a text of length `sa.size()`, where `lcp[0]` is ignored.
+     */
+    template<typename sa_t, typename lcp_t>
+    inline LCPSuffixTree(const sa_t& sa, const lcp_t& lcp) {
+        const len_t n = sa.size();
+        m_leaf_parent.resize(n);
+
+        // the root
+        m_depth.push_back(0);
+        m_lb.push_back(0);
+        m_parent.push_back(0);
+
+        // enumerate the LCP intervals bottom-up
+        std::vector<len_t> stack;
+        stack.push_back(root);
+        for(len_t i = 1; i <= n; ++i) {
+            const len_t cur = (i < n) ? len_t(lcp[i]) : 0;
+
+            // the leaf i-1 belongs to the deepest interval containing it
+            const bool leaf_in_top = cur <= m_depth[stack.back()];
+            if(leaf_in_top) m_leaf_parent[i-1] = stack.back();
+
+            len_t last = root; // the last closed interval, if any
+            while(cur < m_depth[stack.back()]) {
+                last = stack.back();
+                stack.pop_back();
+                // otherwise, the parent is pushed below
+                if(cur <= m_depth[stack.back()]) m_parent[last] = stack.back();
+            }
+
+            if(cur > m_depth[stack.back()]) {
+                const len_t v = m_depth.size();
+                m_depth.push_back(cur);
+                m_lb.push_back(last != root ? m_lb[last] : i-1);
+                m_parent.push_back(root); // assigned when it is closed
+                if(last != root) m_parent[last] = v;
+                stack.push_back(v);
+            }
+
+            if(!leaf_in_top) m_leaf_parent[i-1] = stack.back();
+        }
+        DCHECK_EQ(stack.size(), 1U);
+
+        internal_nodes = m_depth.size();
+
+        // count the children of each node
+        m_first.assign(internal_nodes + 1, 0);
+        for(len_t v = 1; v < internal_nodes; ++v) ++m_first[m_parent[v] + 1];
+        for(len_t i = 0; i < n; ++i) ++m_first[m_leaf_parent[i] + 1];
+        for(len_t v = 0; v < internal_nodes; ++v) m_first[v + 1] += m_first[v];
+
+        // Fill the child lists in the order of the left bounds of the
+        // children, which is the lexicographic order. The internal nodes
+        // starting at position i are exactly the ancestors of the leaf i
+        // with left bound i, and no two of them share a parent.
+        m_children.resize(m_first[internal_nodes]);
+        auto& cursor = m_first;
+        for(len_t i = 0; i < n; ++i) {
+            for(len_t v = m_leaf_parent[i]; v != root && m_lb[v] == i; v = m_parent[v]) {
+                m_children[cursor[m_parent[v]]++] = v;
+            }
+            m_children[cursor[m_leaf_parent[i]]++] = internal_nodes + i;
+        }
+
+        // restore the child offsets, which got shifted by one node
+        for(len_t v = internal_nodes; v > 0; --v) m_first[v] = m_first[v-1];
+        m_first[0] = 0;
+    }
+
+    inline bool is_leaf(node_type v) const {
+        return v >= internal_nodes;
+    }
+
+    inline node_type parent(node_type v) const {
+        return is_leaf(v) ? m_leaf_parent[v - internal_nodes] : m_parent[v];
+    }
+
+    /**
+     * Select the i-th leaf in SA-order
+     * 0 <= i < n
+     */
+    inline node_type select_leaf(len_t i) const {
+        return internal_nodes + i;
+    }
+
+    /**
+     * Returns the child of the internal node `v` on the path to `leaf`,
+     * which must be a descendant of `v`.
+     */
+    inline node_type child_towards(node_type v, node_type leaf) const {
+        DCHECK(!is_leaf(v));
+        const len_t i = leaf - internal_nodes;
+
+        // find the last child whose interval starts at or before i
+        len_t l = m_first[v];
+        len_t r = m_first[v + 1];
+        while(r - l > 1) {
+            const len_t m = l + (r - l) / 2;
+            if(lb(m_children[m]) <= i) l = m; else r = m;
+        }
+        return m_children[l];
+    }
+
+    /*
+     * Returns the length of the label read from the edges on the path from the root to node,
+     * which must be an internal node
+     */
+    inline len_t str_depth(node_type v) const {
+        DCHECK(!is_leaf(v));
+        return m_depth[v];
+    }
+
+    /*
+     * Returns an unique ID for an internal node of the suffix tree
+     */
+    inline len_t nid(node_type v) const {
+        DCHECK(!is_leaf(v));
+        return v;
+    }
+};
+
+}} //ns
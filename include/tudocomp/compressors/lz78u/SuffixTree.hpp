@@ -45,6 +45,17 @@ struct SuffixTree {
 		return cst.bp_support.level_anc(node, cst.node_depth(node)-depth);
 	}
 
+	/**
+	 * Returns the child of node on the path to leaf, which must be a descendant of node.
+	 */
+	cst_t::node_type child_towards(const cst_t::node_type& node, const cst_t::node_type& leaf)const {
+		return level_anc(leaf, cst.node_depth(node)+1);
+	}
+
+	bool is_leaf(const cst_t::node_type& node)const {
+		return cst.is_leaf(node);
+	}
+
 
 	/**
 	 * Select the i-th leaf in SA-order
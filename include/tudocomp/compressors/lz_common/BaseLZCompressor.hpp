@@ -7,6 +7,8 @@
 #include <tudocomp_stat/StatPhase.hpp>
 #include <tudocomp/compressors/lz_common/factorid_t.hpp>
 
+#include <tudocomp/compressors/lz_trie/AutoTrie.hpp>
+
 // For default params
 #include <tudocomp/compressors/lz_trie/TernaryTrie.hpp>
 #include <tudocomp/coders/BinaryCoder.hpp>
@@ -16,7 +18,6 @@ namespace tdc {namespace lz_common {
 template <typename lz_algo_t, typename coder_t, typename dict_t>
 class BaseLZCompressor: public Compressor {
     using factorid_t = lz_common::factorid_t;
-    using node_t = typename dict_t::node_t;
     using encoder_t = typename coder_t::Encoder;
     struct stats_t {
         IF_STATS(size_t dictionary_resets = 0);
@@ -24,8 +25,8 @@ class BaseLZCompressor: public Compressor {
         IF_STATS(size_t total_factor_count = 0);
     };
 
-    using lz_state_t = typename lz_algo_t::template lz_state_t<encoder_t, dict_t, stats_t>;
-    using traverse_state_t = typename lz_state_t::traverse_state_t;
+    template<typename trie_t>
+    using lz_state_t = typename lz_algo_t::template lz_state_t<encoder_t, trie_t, stats_t>;
 
     /// Max dictionary size before reset, 0 == unlimited
     const factorid_t m_dict_max_size {0};
@@ -66,7 +67,12 @@ public:
         return m;
     }
 
-    virtual void compress(Input& input, Output& out) override {
+private:
+    /// Compresses the input using a trie of type `trie_t`.
+    template<typename trie_t>
+    inline void compress_with(const Config& trie_config, Input& input, Output& out) const {
+        using state_t = lz_state_t<trie_t>;
+
         const size_t n = input.size();
         const size_t reserved_size = isqrt(n)*2;
         auto is = input.as_stream();
@@ -81,10 +87,10 @@ public:
         encoder_t coder(config().sub_config("coder"), out, NoLiterals());
 
         // set up dictionary (the lz trie)
-        dict_t dict(config().sub_config("lz_trie"), n, reserved_size + lz_state_t::initial_dict_size());
+        trie_t dict(Config(trie_config), n, reserved_size + state_t::initial_dict_size());
 
         // set up lz algorithm state
-        lz_state_t lz_state { factor_count, coder, dict, stats };
+        state_t lz_state { factor_count, coder, dict, stats };
 
         // set up initial state for trie search
         lz_state.reset_dict();
@@ -114,6 +120,27 @@ public:
         )
     }
 
+    template<typename trie_t>
+    inline void compress_dispatch(Input& input, Output& out, trie_t*) const {
+        compress_with<trie_t>(config().sub_config("lz_trie"), input, out);
+    }
+
+    template<typename... trie_ts>
+    inline void compress_dispatch(Input& input, Output& out,
+                                  lz_trie::AutoTrie<trie_ts...>*) const {
+
+        const lz_trie::AutoTrie<trie_ts...> selector(config().sub_config("lz_trie"));
+        selector.compress(input, out, [&](auto tag, const Config& trie_config,
+                                          Input& in, Output& o) {
+            compress_with<typename decltype(tag)::type>(trie_config, in, o);
+        });
+    }
+
+public:
+    virtual void compress(Input& input, Output& out) override {
+        compress_dispatch(input, out, (dict_t*) nullptr);
+    }
+
     inline std::unique_ptr<Decompressor> decompressor() const override {
         using Decompressor = typename lz_algo_t::template Decompressor<coder_t>;
         // FIXME: construct AST and pass it
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <chrono>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/io.hpp>
+#include <tudocomp/compressors/lz_trie/LZTrie.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace lz_trie {
+
+/// \brief Selects the fastest of several tries for the input.
+///
+/// A prefix of the input is compressed with every candidate trie. Tries
+/// with a `load_factor` parameter are additionally tried with each of the
+/// configured load factors. The fastest trial whose memory peak is within
+/// `max_mem_ratio` of the smallest one is then used for the whole input.
+///
+/// This is not a trie itself; compressors that support it dispatch to the
+/// selected trie via \ref compress.
+template<typename... trie_ts>
+class AutoTrie : public Algorithm {
+    using candidates_t = std::tuple<trie_ts...>;
+
+    template<typename trie_t>
+    struct tag {
+        using type = trie_t;
+    };
+
+    struct Trial {
+        size_t candidate;
+        Config config;
+    };
+
+    /// Calls `f(tag<T>())` for the `i`-th candidate type `T`.
+    template<typename f_t, size_t... Is>
+    inline static void visit(size_t i, f_t& f, std::index_sequence<Is...>) {
+        (void) std::initializer_list<int> {
+            (i == Is ? (f(tag<typename std::tuple_element<Is, candidates_t>::type>()), 0) : 0)...
+        };
+    }
+
+    template<typename f_t>
+    inline static void visit(size_t i, f_t f) {
+        visit(i, f, std::index_sequence_for<trie_ts...>());
+    }
+
+    inline static bool has_load_factor(const Config& cfg) {
+        for(auto& p : cfg.decl()->params()) {
+            if(p.name() == "load_factor") return true;
+        }
+        return false;
+    }
+
+    inline std::vector<Trial> trials() const {
+        std::vector<Trial> trials;
+        const auto load_factors = config().param("load_factors").as_vector<size_t>();
+
+        auto& candidates = config().sub_configs("candidates");
+        for(size_t i = 0; i < candidates.size(); ++i) {
+            const Config& cfg = candidates[i];
+            trials.push_back(Trial { i, cfg });
+            if(!has_load_factor(cfg)) continue;
+
+            const size_t configured = cfg.param("load_factor").as_uint();
+            for(size_t lf : load_factors) {
+                if(lf == configured) continue;
+
+                // the candidate's configuration with another load factor
+                meta::ast::Object lf_obj(cfg.decl()->name());
+                lf_obj.add_param(meta::ast::Param("load_factor",
+                    std::make_shared<meta::ast::Value>(std::to_string(lf))));
+                auto obj = lf_obj.inherit(meta::ast::convert<meta::ast::Object>(
+                    meta::ast::Parser::parse(cfg.str())));
+
+                visit(i, [&](auto t) {
+                    using trie_t = typename decltype(t)::type;
+                    trials.push_back(Trial { i, trie_t::meta().config(obj) });
+                });
+            }
+        }
+        return trials;
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m(LZTrie<>::lz_trie_type(), "auto",
+            "Selects the fastest trie on a prefix of the input.");
+        m.param("candidates", "The tries to choose from.")
+            .strategy_list<trie_ts...>(LZTrie<>::lz_trie_type(),
+                Meta::Defaults<trie_ts...>());
+        m.param("load_factors",
+            "The load factors (in percent) tried for hash based tries.")
+            .primitive_list({30, 50, 90});
+        m.param("sample", "The length of the input prefix to try.")
+            .primitive(256 * 1024);
+        m.param("max_mem_ratio",
+            "The maximum memory peak of the selected trie, relative to the "
+            "trial with the smallest one.").primitive(2.0);
+        return m;
+    }
+
+    using Algorithm::Algorithm;
+
+    /// \brief Compresses the input with the selected trie.
+    ///
+    /// `run(tag, trie_config, input, output)` has to compress the input
+    /// using a trie of type `decltype(tag)::type`. It is called once for
+    /// each trial on the prefix, and then for the whole input.
+    template<typename run_t>
+    inline void compress(Input& input, Output& output, run_t run) const {
+        const std::vector<Trial> trials = this->trials();
+        size_t best = 0;
+
+        StatPhase::wrap("Select lz_trie", [&]{
+            const size_t sample_size = std::min<size_t>(
+                input.size(), config().param("sample").as_uint());
+            if(trials.size() < 2 || sample_size == 0) return;
+
+            // read the prefix
+            std::vector<uint8_t> sample;
+            {
+                sample.reserve(sample_size);
+
+                auto is = input.as_stream();
+                char c;
+                while(sample.size() < sample_size && is.get(c)) {
+                    sample.push_back(uint8_t(c));
+                }
+            }
+
+            std::vector<double> time(trials.size());
+            std::vector<size_t> mem(trials.size());
+            size_t min_mem = std::numeric_limits<size_t>::max();
+
+            for(size_t i = 0; i < trials.size(); ++i) {
+                const Trial& trial = trials[i];
+
+                StatPhase phase(trial.config.str());
+                std::vector<uint8_t> discard;
+                {
+                    Input trial_input(sample);
+                    Output trial_output(discard);
+
+                    const auto start = std::chrono::steady_clock::now();
+                    visit(trial.candidate, [&](auto t) {
+                        run(t, trial.config, trial_input, trial_output);
+                    });
+                    time[i] = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start).count();
+                }
+
+                // the memory peak is only known if the phases are tracked
+                const json stats = phase.to_json();
+                mem[i] = (stats.is_object() && stats.count("memPeak"))
+                    ? stats["memPeak"].get<size_t>() : 0;
+                min_mem = std::min(min_mem, mem[i]);
+            }
+
+            const double max_mem = min_mem * config().param("max_mem_ratio").as_double();
+            for(size_t i = 1; i < trials.size(); ++i) {
+                if(mem[i] <= max_mem && (time[i] < time[best] || mem[best] > max_mem)) {
+                    best = i;
+                }
+            }
+
+            StatPhase::log("trials", trials.size());
+            StatPhase::log("selected", trials[best].config.str());
+            StatPhase::log("selected time (s)", time[best]);
+            StatPhase::log("selected memory peak", mem[best]);
+        });
+
+        visit(trials[best].candidate, [&](auto t) {
+            run(t, trials[best].config, input, output);
+        });
+    }
+};
+
+}} //ns
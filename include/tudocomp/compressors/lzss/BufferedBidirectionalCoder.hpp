@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
 #include <tudocomp/compressors/lzss/LZSSCoder.hpp>
 
@@ -77,9 +79,7 @@ public:
                 m_lenc->encode(q-p, m_run_r);
                 m_lenc->flush();
 
-                while(p < q) {
-                    m_litc->encode(text[p++], uliteral_r);
-                }
+                m_litc->encode_many(text.begin() + p, text.begin() + q, uliteral_r);
 
                 m_litc->flush();
             }
@@ -145,7 +145,8 @@ public:
             const size_t longest_run = m_lend->template decode<size_t>(ref_r);
             MinDistributedRange run_r(1, longest_run);
 
-            // decode text
+            // decode text, literal runs are decoded blockwise
+            std::array<uliteral_t, 1024> run_block;
             while(!m_litd->eof()) {
                 auto is_factor = m_litd->template decode<bool>(bit_r);
                 if(is_factor) {
@@ -155,9 +156,13 @@ public:
                     decomp.decode_factor(fsrc, flen);
                 } else {
                     size_t run = m_lend->template decode<size_t>(run_r);
-                    while(run--) {
-                        auto c = m_litd->template decode<uliteral_t>(literal_r);
-                        decomp.decode_literal(c);
+                    while(run > 0) {
+                        const size_t k = std::min(run, run_block.size());
+                        m_litd->decode_many(run_block.begin(), run_block.begin() + k, literal_r);
+                        for(size_t i = 0; i < k; i++) {
+                            decomp.decode_literal(run_block[i]);
+                        }
+                        run -= k;
                     }
                 }
             }
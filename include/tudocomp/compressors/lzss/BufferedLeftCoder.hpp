@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
 #include <tudocomp/compressors/lzss/LZSSCoder.hpp>
 
@@ -13,7 +15,8 @@ namespace lzss {
 ///
 /// It only allows left-references, i.e., factors may only refer to prior
 /// positions in the text. Each run of literals is preceded by the run's
-/// length.
+/// length. The maximum distance between a factor and its source is recorded
+/// in the header, so the decoder only needs to keep a window of that size.
 template<typename ref_coder_t, typename len_coder_t, typename lit_coder_t>
 class BufferedLeftCoder : public LZSSCoder<ref_coder_t, len_coder_t, lit_coder_t> {
 private:
@@ -34,6 +37,7 @@ public:
         std::unique_ptr<lenc_t> m_lenc;
         std::unique_ptr<litc_t> m_litc;
         Range m_flen_r, m_run_r;
+        size_t m_max_ref;
 
     public:
         /// \brief Constructor.
@@ -46,7 +50,8 @@ public:
               m_lenc(std::move(lenc)),
               m_litc(std::move(litc)),
               m_flen_r(LengthRange()),
-              m_run_r(LengthRange())
+              m_run_r(LengthRange()),
+              m_max_ref(0)
         {
         }
 
@@ -54,6 +59,7 @@ public:
             m_lenc->encode(m_flen_r.min(), LengthRange());
             m_lenc->encode(m_flen_r.max(), LengthRange());
             m_lenc->encode(m_run_r.max(), LengthRange());
+            m_lenc->encode(m_max_ref, LengthRange());
             m_lenc->flush();
         }
 
@@ -65,7 +71,7 @@ public:
 
             m_litc->encode(true, bit_r);
             m_litc->flush();
-            m_refc->encode(f.pos - f.src, Range(1, f.pos));
+            m_refc->encode(f.pos - f.src, Range(1, std::min(size_t(f.pos), m_max_ref)));
             m_refc->flush();
             m_lenc->encode(f.len, m_flen_r);
             m_lenc->flush();
@@ -79,9 +85,7 @@ public:
                 m_lenc->encode(q-p, m_run_r);
                 m_lenc->flush();
 
-                while(p < q) {
-                    m_litc->encode(text[p++], uliteral_r);
-                }
+                m_litc->encode_many(text.begin() + p, text.begin() + q, uliteral_r);
 
                 m_litc->flush();
             }
@@ -98,13 +102,19 @@ public:
             // analyze factorization
             size_t longest_run = 0;
             size_t p = 0;
+            m_max_ref = 0;
             for(auto& f : factors) {
                 longest_run = std::max(longest_run, f.pos - p);
                 p = f.pos + f.len;
+
+                if(f.pos > f.src) {
+                    m_max_ref = std::max(m_max_ref, size_t(f.pos - f.src));
+                }
             }
             longest_run = std::max(longest_run, text.size() - p);
             m_run_r = MinDistributedRange(1, longest_run);
             DLOG(INFO) << "longest_run = " << longest_run;
+            DLOG(INFO) << "max_ref = " << m_max_ref;
 
             // encode
             factors.encode_text(text, *this);
@@ -143,22 +153,31 @@ public:
             const size_t longest_run = m_lend->template decode<size_t>(LengthRange());
             MinDistributedRange run_r(1, longest_run);
 
-            // decode text
+            const size_t max_ref = m_lend->template decode<size_t>(LengthRange());
+            initialize_window(decomp, max_ref);
+
+            // decode text, literal runs are decoded blockwise
+            std::array<uliteral_t, 1024> run_block;
             size_t p = 0;
             while(!m_litd->eof()) {
                 auto is_factor = m_litd->template decode<bool>(bit_r);
                 if(is_factor) {
-                    size_t fsrc = p - m_refd->template decode<size_t>(Range(1, p));
+                    size_t fsrc = p - m_refd->template decode<size_t>(
+                        Range(1, std::min(p, max_ref)));
                     size_t flen = m_lend->template decode<size_t>(flen_r);
 
                     decomp.decode_factor(fsrc, flen);
                     p += flen;
                 } else {
                     size_t run = m_lend->template decode<size_t>(run_r);
-                    while(run--) {
-                        auto c = m_litd->template decode<uliteral_t>(literal_r);
-                        decomp.decode_literal(c);
-                        ++p;
+                    while(run > 0) {
+                        const size_t k = std::min(run, run_block.size());
+                        m_litd->decode_many(run_block.begin(), run_block.begin() + k, literal_r);
+                        for(size_t i = 0; i < k; i++) {
+                            decomp.decode_literal(run_block[i]);
+                        }
+                        p += k;
+                        run -= k;
                     }
                 }
             }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/util.hpp>
+
+namespace tdc {
+namespace lzss {
+
+/// \brief Decodes a left-reference factorization and writes the decoded
+///        text to an output stream while decoding.
+///
+/// If the decoder reports the maximum reference distance via
+/// \ref initialize_window, only a ring buffer covering that distance is kept
+/// and the decoded text is flushed to the output whenever the ring buffer is
+/// full. Otherwise, the whole text is kept and written in \ref process.
+class DecompStreamBuffer {
+private:
+    /// The minimum ring buffer size, so the output is written in large chunks.
+    static constexpr size_t MIN_RING_BITS = 16;
+
+    std::ostream* m_out;
+    std::vector<uliteral_t> m_buffer;
+
+    bool m_ring; // whether the buffer is a ring buffer
+    size_t m_mask;
+
+    size_t m_pos;     // the number of decoded characters
+    size_t m_flushed; // the number of written characters
+
+    inline void flush() {
+        const size_t n = m_pos - m_flushed;
+        const size_t start = m_ring ? (m_flushed & m_mask) : m_flushed;
+        const size_t first = std::min(n, m_buffer.size() - start);
+
+        m_out->write((const char*)m_buffer.data() + start, first);
+        m_out->write((const char*)m_buffer.data(), n - first);
+        m_flushed = m_pos;
+    }
+
+    inline void push(uliteral_t c) {
+        if(m_ring) {
+            if(m_pos - m_flushed == m_buffer.size()) flush();
+            m_buffer[m_pos & m_mask] = c;
+        } else {
+            m_buffer.emplace_back(c);
+        }
+        ++m_pos;
+    }
+
+public:
+    /// \brief Constructor.
+    /// \param out The stream to write the decoded text to.
+    inline DecompStreamBuffer(std::ostream& out)
+        : m_out(&out), m_ring(false), m_mask(0), m_pos(0), m_flushed(0) {
+    }
+
+    inline void initialize(size_t n) {
+        m_buffer.reserve(n);
+    }
+
+    /// \brief Restricts the buffer to a window of the decoded text.
+    ///
+    /// Has to be called before anything is decoded.
+    ///
+    /// \param max_ref The maximum distance between a factor and its source,
+    ///                or zero if it is not bounded.
+    inline void initialize_window(size_t max_ref) {
+        DCHECK_EQ(m_pos, 0U);
+        if(max_ref > 0) {
+            const size_t bits = std::max(size_t(bits_for(max_ref)), size_t(MIN_RING_BITS));
+            m_buffer = std::vector<uliteral_t>(size_t(1) << bits);
+            m_mask = m_buffer.size() - 1;
+            m_ring = true;
+        }
+    }
+
+    inline void decode_literal(uliteral_t c) {
+        push(c);
+    }
+
+    inline void decode_factor(len_t src, len_t len) {
+        if(m_ring) {
+            DCHECK_LE(m_pos - src, m_buffer.size())
+                << "reference exceeds the window";
+            while(len--) push(m_buffer[(src++) & m_mask]);
+        } else {
+            while(len--) push(m_buffer[src++]);
+        }
+    }
+
+    /// \brief Writes the part of the decoded text that has not been
+    ///        written yet.
+    inline void process() {
+        flush();
+    }
+
+    inline len_t longest_chain() const {
+        return 0;
+    }
+
+    /// \brief Returns the number of decoded characters.
+    inline size_t size() const {
+        return m_pos;
+    }
+
+    /// \brief Returns the current size of the buffer.
+    inline size_t buffer_size() const {
+        return m_buffer.size();
+    }
+};
+
+}} //ns
@@ -61,6 +61,10 @@ public:
         inline void factor_length_range(Range) {
             // ignore (not needed)
         }
+
+        inline void max_reference_distance(size_t) {
+            // ignore (not needed)
+        }
     };
 
     class Decoder {
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+#include <utility>
+
 #include <tudocomp/io.hpp>
 #include <tudocomp/Range.hpp>
 #include <tudocomp/Literal.hpp>
@@ -17,6 +20,36 @@ static inline constexpr TypeDesc lzss_bidirectional_coder_type() {
 
 namespace lzss {
 
+/// \cond INTERNAL
+template<typename decomp_t, typename = void>
+struct has_window : std::false_type {};
+
+template<typename decomp_t>
+struct has_window<decomp_t,
+    decltype(void(std::declval<decomp_t&>().initialize_window(size_t())))>
+    : std::true_type {};
+
+template<typename decomp_t>
+inline void initialize_window(decomp_t& decomp, size_t max_ref, std::true_type) {
+    decomp.initialize_window(max_ref);
+}
+
+template<typename decomp_t>
+inline void initialize_window(decomp_t&, size_t, std::false_type) {
+    // the decompression strategy keeps the whole text anyway
+}
+/// \endcond
+
+/// \brief Passes the maximum reference distance decoded from a header to
+///        a decompression strategy that supports bounded windows.
+///
+/// \param decomp the decompression strategy
+/// \param max_ref the maximum reference distance, or zero if unbounded
+template<typename decomp_t>
+inline void initialize_window(decomp_t& decomp, size_t max_ref) {
+    initialize_window(decomp, max_ref, has_window<decomp_t>());
+}
+
 /// \brief Base coder for LZ77-style factorizations in a
 ///        Storer-Symanszki manner (references and literal symbols).
 ///
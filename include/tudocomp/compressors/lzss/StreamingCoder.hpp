@@ -12,6 +12,9 @@ namespace lzss {
 /// buffered and nothing is known about the text in advance.
 ///
 /// Naturally, this only allows for references to prior positions in the text.
+/// If the maximum distance between a factor and its source is known, it is
+/// recorded in the header so the decoder only needs to keep a window of that
+/// size.
 template<typename ref_coder_t, typename len_coder_t, typename lit_coder_t>
 class StreamingCoder : public LZSSCoder<ref_coder_t, len_coder_t, lit_coder_t> {
 private:
@@ -32,6 +35,11 @@ public:
         std::unique_ptr<lenc_t> m_lenc;
         std::unique_ptr<litc_t> m_litc;
         Range m_flen_r;
+        size_t m_max_ref; // zero if unbounded
+
+        inline Range ref_r(size_t pos) const {
+            return Range(1, m_max_ref ? std::min(pos, m_max_ref) : pos);
+        }
 
     public:
         /// \brief Constructor.
@@ -43,7 +51,8 @@ public:
             : m_refc(std::move(refc)),
               m_lenc(std::move(lenc)),
               m_litc(std::move(litc)),
-              m_flen_r(LengthRange())
+              m_flen_r(LengthRange()),
+              m_max_ref(0)
         {
         }
 
@@ -52,9 +61,16 @@ public:
             m_flen_r = MinDistributedRange(r);
         }
 
+        /// \brief Sets the maximum distance between a factor and its source.
+        /// \param max_ref the maximum distance, or zero if unbounded
+        inline void max_reference_distance(size_t max_ref) {
+            m_max_ref = max_ref;
+        }
+
         inline void encode_header() {
             m_lenc->encode(m_flen_r.min(), LengthRange());
             m_lenc->encode(m_flen_r.max(), LengthRange());
+            m_lenc->encode(m_max_ref, LengthRange());
             m_lenc->flush();
         }
 
@@ -66,7 +82,10 @@ public:
 
             m_litc->encode(true, bit_r); // 1-bit to indicate factor
             m_litc->flush(); // context switch
-            m_refc->encode(f.pos - f.src, Range(1, f.pos)); // delta
+            DCHECK(m_max_ref == 0 || f.pos - f.src <= m_max_ref)
+                << "reference exceeds the maximum distance";
+
+            m_refc->encode(f.pos - f.src, ref_r(f.pos)); // delta
             m_refc->flush(); // context switch
             m_lenc->encode(f.len, m_flen_r);
             m_lenc->flush(); // context switch
@@ -89,6 +108,14 @@ public:
             const factorbuffer_t& factors) {
 
             m_flen_r = factors.factor_length_range();
+
+            m_max_ref = 0;
+            for(auto& f : factors) {
+                if(f.pos > f.src) {
+                    m_max_ref = std::max(m_max_ref, size_t(f.pos - f.src));
+                }
+            }
+
             factors.encode_text(text, *this);
         }
     };
@@ -122,12 +149,16 @@ public:
             const size_t flen_max = m_lend->template decode<size_t>(LengthRange());
             MinDistributedRange flen_r(flen_min, flen_max);
 
+            const size_t max_ref = m_lend->template decode<size_t>(LengthRange());
+            initialize_window(decomp, max_ref);
+
             // decode text
             size_t p = 0;
             while(!m_litd->eof()) {
                 auto is_factor = m_litd->template decode<bool>(bit_r);
                 if(is_factor) {
-                    size_t fsrc = p - m_refd->template decode<size_t>(Range(1, p));
+                    const Range ref_r(1, max_ref ? std::min(p, max_ref) : p);
+                    size_t fsrc = p - m_refd->template decode<size_t>(ref_r);
                     size_t flen = m_lend->template decode<size_t>(flen_r);
 
                     decomp.decode_factor(fsrc, flen);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+
+#include <tudocomp/io.hpp>
+#include <tudocomp/Decompressor.hpp>
+#include <tudocomp/meta/Registry.hpp>
+
+namespace tdc {
+
+/// Decompresses the output of the \ref AutoCompressor.
+///
+/// The output starts with the null-terminated configuration of the
+/// decompressor for the selected compressor, followed by the serialized
+/// input restrictions it was applied with. The decompressor restores the
+/// remainder and the restrictions are undone on its output.
+class AutoDecompressor : public Decompressor {
+public:
+    inline static Meta meta() {
+        Meta m(Decompressor::type_desc(), "auto",
+            "Decompresses using the decompressor recorded in the input.");
+        return m;
+    }
+
+    using Decompressor::Decompressor;
+
+    virtual void decompress(Input& input, Output& output) override {
+        std::string header;
+        InputRestrictions restrictions;
+        size_t offset;
+        {
+            auto is = input.as_stream();
+            char c;
+            while(is.get(c) && c != '\0') header.push_back(c);
+            offset = header.size() + 1 + restrictions.deserialize(is);
+        }
+
+        auto decompressor = Registry::of<Decompressor>().select(header).move_instance();
+
+        Input payload(input, offset);
+        if(restrictions.has_restrictions()) {
+            Output unrestricted(output, restrictions);
+            decompressor->decompress(payload, unrestricted);
+        } else {
+            decompressor->decompress(payload, output);
+        }
+    }
+};
+
+}
@@ -38,6 +38,26 @@ public:
             out << ""_v;
         }
     }
+
+    inline virtual void extract(Input& input, Output& output,
+                                size_t offset, size_t length) override {
+        StatPhase phase0("ESP Extract");
+
+        StatPhase phase1("Creating strategy");
+        const slp_coder_t strategy { this->config().sub_config("slp_coder") };
+
+        phase1.split("Decode SLP");
+        auto slp = strategy.decode(input);
+
+        phase1.split("Compute rule lengths");
+        slp.compute_lengths();
+
+        phase1.split("Create output stream");
+        auto out = output.as_stream();
+
+        phase1.split("Extract range");
+        slp.extract_text(out, offset, length);
+    }
 };
 
 }
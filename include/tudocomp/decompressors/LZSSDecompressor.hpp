@@ -1,7 +1,8 @@
 #pragma once
 
 #include <tudocomp/Decompressor.hpp>
-#include <tudocomp/compressors/lzss/DecompBackBuffer.hpp>
+#include <tudocomp/compressors/lzss/DecompStreamBuffer.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
 
 namespace tdc {
     template<typename lzss_coder_t>
@@ -34,9 +35,18 @@ namespace tdc {
         }
 
     public:
+        /// Decodes the text while writing it to the output. If the coder
+        /// records the maximum reference distance in the header, only a
+        /// window of that size is kept in memory.
         inline virtual void decompress(Input& input, Output& output) override {
-            lzss::DecompBackBuffer decomp;
-            decompress_internal(decomp, input, output);
+            auto outs = output.as_stream();
+            lzss::DecompStreamBuffer decomp(outs);
+
+            auto decoder = lzss_coder_t(
+                config().sub_config("decoder")).decoder(input);
+
+            decoder.decode(decomp);
+            StatPhase::log("buffer size", decomp.buffer_size());
         }
     };
 }
@@ -41,6 +41,12 @@ public:
         static_cast<CompressorAndDecompressor*>(m_c.get())->decompress(
             input, output);
     }
+
+    virtual void extract(Input& input, Output& output,
+                         size_t offset, size_t length) override {
+        static_cast<CompressorAndDecompressor*>(m_c.get())->extract(
+            input, output, offset, length);
+    }
 };
 
 }
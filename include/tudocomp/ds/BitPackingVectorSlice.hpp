@@ -23,6 +23,7 @@
 #include <glog/logging.h>
 
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
 
 /// \cond INTERNAL
 
@@ -230,6 +231,22 @@ namespace int_vector {
             return this->raw_width();
         }
 
+        /// Decodes \c count elements starting at index \c begin into \c out
+        /// at once, see \ref bulk::unpack.
+        inline void unpack(size_type begin, size_type count, uint64_t* out) const {
+            DCHECK(begin + count <= size());
+            bulk::unpack(this->m_vec.data(), this->m_offset + elem2bits(begin),
+                width(), count, out);
+        }
+
+        /// Returns a reader that decodes the elements starting at index
+        /// \c begin in blocks, see \ref bulk::Reader.
+        inline bulk::Reader reader(size_type begin = 0) const {
+            DCHECK(begin <= size());
+            return bulk::Reader(this->m_vec.data(),
+                this->m_offset + elem2bits(begin), width(), size() - begin);
+        }
+
         inline BitPackingVectorSlice slice(size_t from, size_t to = size_t(-1)) const {
             if (to == size_t(-1)) {
                 to = size();
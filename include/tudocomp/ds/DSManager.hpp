@@ -17,6 +17,7 @@
 #include <tudocomp/ds/CompressMode.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/DSDependencyGraph.hpp>
+#include <tudocomp/ds/DSScheduler.hpp>
 
 namespace tdc {
 
@@ -133,6 +134,7 @@ private:
 
     View m_input;      // TODO: use Input instead of View?
     CompressMode m_cm; // the compression mode
+    size_t m_threads;  // the maximum amount of concurrent constructions
 
     std::set<dsid_t> m_protect;     // used temporarily during construction
     std::set<dsid_t> m_constructed; // marks a data structure as constructed
@@ -143,6 +145,9 @@ public:
         Meta m(ds::type(), "ds");
         m.param("providers").strategy_list<provider_ts...>(ds::provider_type());
         m.param("compress").primitive("delayed");
+        m.param("threads",
+            "The maximum amount of data structures to construct "
+            "concurrently.").primitive(1);
         m.inherit_tags_from_all(tl::type_list<provider_ts...>());
         return m;
     }
@@ -165,6 +170,8 @@ public:
         } else {
             m_cm = CompressMode::plain;
         }
+
+        m_threads = this->config().param("threads").as_uint();
     }
 
     template<dsid_t dsid>
@@ -227,16 +234,19 @@ public:
         ensure_provider<ds>();
         if(!is_constructed(ds)) {
             get_provider<ds>().template construct(*this, compressed_space);
-
-            m_constructed.emplace(ds);
-            if(compressed_space) {
-                m_compressed.emplace(ds);
-            }
+            mark_constructed(ds, compressed_space);
         } else if(compressed_space) {
             compress<ds>();
         }
     }
 
+    inline void mark_constructed(const dsid_t ds, bool compressed_space) {
+        m_constructed.emplace(ds);
+        if(compressed_space) {
+            m_compressed.emplace(ds);
+        }
+    }
+
     template<dsid_t ds>
     inline void compress() {
         ensure_provider<ds>();
@@ -262,11 +272,15 @@ public:
 
     /// \brief Constructs the specified data structures.
     ///
+    /// If the \c threads parameter is greater than one, independent data
+    /// structures are constructed concurrently (see \ref DSScheduler).
+    ///
     /// \tparam ds the data structures to construct.
     template<dsid_t... ds>
     inline void construct() {
         // build dependency graph
         using depgraph_t = DSDependencyGraph<this_t, ds...>;
+        using scheduler_t = DSScheduler<this_t, ds...>;
 
         // init protection to all requested data structures
         m_protect = is::to_set(std::index_sequence<ds...>());
@@ -277,7 +291,11 @@ public:
         }
 
         // construct
-        depgraph_t(*this, m_cm);
+        if(m_threads > 1) {
+            scheduler_t(*this, m_cm, m_threads);
+        } else {
+            depgraph_t(*this, m_cm);
+        }
 
         // revoke protection
         m_protect.clear();
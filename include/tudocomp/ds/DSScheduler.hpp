@@ -0,0 +1,382 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/util.hpp>
+#include <tudocomp/ds/DSDef.hpp>
+#include <tudocomp/ds/DSDependencyGraph.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace tdc {
+
+/// \brief Constructs data structures concurrently by walking their
+///        dependency graph.
+///
+/// Other than \ref DSDependencyGraph, which constructs the data structures
+/// one after another in a depth-first manner, the scheduler proceeds in
+/// rounds. In each round, the data structures whose requirements are all
+/// available are "ready" and a batch of them is constructed concurrently,
+/// e.g., the inverse suffix array and the Phi array, which both only require
+/// the suffix array. Batches are run using OpenMP; without OpenMP, the
+/// construction is sequential.
+///
+/// After each round, the same bookkeeping as in \ref DSDependencyGraph takes
+/// place: byproducts are discarded, data structures no longer required by
+/// any node are discarded, and, in case of delayed compression, requested
+/// data structures are compressed once nothing depends on them anymore.
+/// Data structures required by more than one node are protected, so
+/// providers running in the same round never consume a shared data
+/// structure in-place.
+///
+/// To keep the memory peak in check, every data structure is estimated to
+/// take up an integer array over the input, and the scheduler first
+/// simulates a sequential run. Providers that need temporary memory during
+/// construction can declare it with a static member function
+/// <tt>construction_overhead(n)</tt> returning the amount of bytes for an
+/// input of length \c n; it is added while the provider is running. A batch is only extended by another data
+/// structure as long as the estimated amount of memory in use stays within
+/// the peak of that simulation.
+///
+/// Since phase tracking is not thread-safe, a batch of more than one data
+/// structure is tracked as a single phase. The providers of such a batch
+/// run with tracking paused, so their own phases and statistics are not
+/// recorded.
+///
+/// \tparam manager_t the data structure manager's type
+/// \tparam m_construct the data structures to construct
+template<typename manager_t, dsid_t... m_construct>
+class DSScheduler {
+private:
+    using depgraph_t = DSDependencyGraph<manager_t, m_construct...>;
+
+    template<dsid_t ds>
+    using provider_t = typename manager_t::template provider_type<ds>;
+
+    using op_t = void (*)(manager_t&, bool);
+
+    template<dsid_t ds>
+    static void build_op(manager_t& manager, bool compressed_space) {
+        manager.template get_provider<ds>().construct(manager, compressed_space);
+    }
+
+    template<dsid_t ds>
+    static void discard_op(manager_t& manager, bool) {
+        manager.template discard<ds>(true);
+    }
+
+    template<dsid_t ds>
+    static void compress_op(manager_t& manager, bool) {
+        manager.template compress<ds>();
+    }
+
+    struct Node {
+        dsid_t id;
+        size_t cost;
+        size_t overhead; // temporary memory needed for construction
+        bool requested;
+        const void* provider; // identifies the provider instance
+
+        dsid_list_t requires;
+        std::vector<std::pair<dsid_t, op_t>> provides;
+
+        op_t build;
+        op_t discard;
+        op_t compress;
+    };
+
+    // the state of a (possibly simulated) construction
+    struct State {
+        std::set<dsid_t> constructed;
+        std::map<dsid_t, size_t> degree; // amount of pending dependants
+        size_t live = 0; // estimated memory in use
+        size_t peak = 0;
+    };
+
+    manager_t* m_manager;
+    CompressMode m_cm;
+    size_t m_ds_size; // estimated memory size of a single data structure
+
+    std::map<dsid_t, Node> m_nodes;
+
+    // the construction overhead declared by a provider, if any
+    template<typename provider_t>
+    static auto overhead_of(size_t n, int)
+        -> decltype(provider_t::construction_overhead(n)) {
+        return provider_t::construction_overhead(n);
+    }
+
+    template<typename provider_t>
+    static size_t overhead_of(size_t, long) {
+        return 0;
+    }
+
+    template<dsid_t ds>
+    static constexpr bool is_requested() {
+        return is::contains_idx<ds, std::index_sequence<m_construct...>>();
+    }
+
+    inline void add_provides(Node&, std::index_sequence<>) {
+    }
+
+    template<dsid_t Head, dsid_t... Tail>
+    inline void add_provides(Node& node, std::index_sequence<Head, Tail...>) {
+        node.provides.emplace_back(Head, &discard_op<Head>);
+        add_provides(node, std::index_sequence<Tail...>());
+    }
+
+    inline void add_nodes(std::index_sequence<>) {
+        // end of a construction path
+    }
+
+    template<dsid_t Head, dsid_t... Tail>
+    inline void add_nodes(std::index_sequence<Head, Tail...>) {
+        m_manager->template ensure_provider<Head>();
+
+        if(m_nodes.find(Head) == m_nodes.end()) {
+            Node node;
+            node.id = Head;
+            node.cost = depgraph_t::template cost<Head>();
+            node.overhead = overhead_of<provider_t<Head>>(
+                m_manager->input.size(), 0);
+            node.requested = is_requested<Head>();
+            node.provider = &m_manager->template get_provider<Head>();
+            node.requires = is::to_vector(typename provider_t<Head>::requires());
+            add_provides(node, typename provider_t<Head>::provides());
+            node.build = &build_op<Head>;
+            node.discard = &discard_op<Head>;
+            node.compress = &compress_op<Head>;
+            m_nodes.emplace(Head, std::move(node));
+
+            // the requirements of data structures that are already
+            // available need not be constructed
+            if(!m_manager->is_constructed(Head)) {
+                add_nodes(typename provider_t<Head>::requires());
+            }
+        }
+
+        // next
+        add_nodes(std::index_sequence<Tail...>());
+    }
+
+    inline State initial_state() const {
+        State s;
+        for(auto& e : m_nodes) {
+            const Node& node = e.second;
+            if(m_manager->is_constructed(node.id)) {
+                s.constructed.emplace(node.id);
+                s.live += m_ds_size;
+            } else {
+                for(dsid_t r : node.requires) ++s.degree[r];
+            }
+        }
+        s.peak = s.live;
+        return s;
+    }
+
+    inline size_t degree(const State& s, dsid_t ds) const {
+        auto it = s.degree.find(ds);
+        return (it != s.degree.end()) ? it->second : 0;
+    }
+
+    inline bool is_ready(const State& s, const Node& node) const {
+        if(s.constructed.count(node.id)) return false;
+        for(dsid_t r : node.requires) {
+            if(!s.constructed.count(r)) return false;
+        }
+        return true;
+    }
+
+    // selects the next batch of ready nodes (highest cost first)
+    inline std::vector<const Node*> next_batch(
+        const State& s, size_t threads, size_t budget) const {
+
+        std::vector<const Node*> ready;
+        for(auto& e : m_nodes) {
+            if(is_ready(s, e.second)) ready.push_back(&e.second);
+        }
+        std::stable_sort(ready.begin(), ready.end(),
+            [](const Node* a, const Node* b){ return a->cost > b->cost; });
+
+        std::vector<const Node*> batch;
+        size_t mem = s.live;
+        for(const Node* node : ready) {
+            if(batch.size() >= threads) break;
+
+            // a provider instance must not construct twice at once
+            const bool shares_provider = std::any_of(
+                batch.begin(), batch.end(),
+                [&](const Node* other){ return other->provider == node->provider; });
+            if(shares_provider) continue;
+
+            const size_t need = m_ds_size + node->overhead;
+            if(!batch.empty() && mem + need > budget) continue;
+
+            batch.push_back(node);
+            mem += need;
+        }
+        return batch;
+    }
+
+    inline void build(const std::vector<const Node*>& batch) {
+        const bool compressed_space = (m_cm == CompressMode::compressed);
+
+        if(batch.size() == 1) {
+            batch[0]->build(*m_manager, compressed_space);
+            return;
+        }
+
+        // phase tracking is not thread-safe, so the whole batch is tracked
+        // as a single phase and the providers run with tracking paused
+        std::stringstream title;
+        title << "Construct";
+        for(const Node* node : batch) {
+            title << ((node == batch.front()) ? " " : ", ")
+                  << ds::name_for(node->id);
+        }
+        StatPhase phase(title.str());
+        phase.log_stat("threads", batch.size());
+
+        // exceptions must not escape a parallel region
+        std::vector<std::exception_ptr> errors(batch.size());
+        const ssize_t num = batch.size();
+
+        StatPhase::pause_tracking();
+
+        #ifdef ENABLE_OPENMP
+        #pragma omp parallel for num_threads(num) schedule(static, 1)
+        #endif
+        for(ssize_t i = 0; i < num; i++) {
+            try {
+                batch[i]->build(*m_manager, compressed_space);
+            } catch(...) {
+                errors[i] = std::current_exception();
+            }
+        }
+
+        StatPhase::resume_tracking();
+
+        for(auto& e : errors) {
+            if(e) std::rethrow_exception(e);
+        }
+    }
+
+    inline void possibly_compress(const State& s, const Node& node, bool dry) {
+        // the only remaining edge leads to CONSTRUCT
+        if(!dry && m_cm == CompressMode::delayed &&
+            node.requested && degree(s, node.id) == 0) {
+
+            node.compress(*m_manager, true);
+        }
+    }
+
+    // performs the bookkeeping after a node has been constructed
+    inline void finish(State& s, const Node& node, bool dry) {
+        const bool compressed_space = (m_cm == CompressMode::compressed);
+
+        if(!dry) {
+            m_manager->mark_constructed(node.id, compressed_space);
+
+            // discard byproducts
+            for(auto& p : node.provides) {
+                if(m_nodes.find(p.first) == m_nodes.end()) {
+                    p.second(*m_manager, true);
+                }
+            }
+        }
+
+        // decrease degree of direct dependencies
+        for(dsid_t r : node.requires) {
+            const Node& req = m_nodes.at(r);
+            const size_t d = --s.degree.at(r);
+
+            if(d == 0 && !req.requested) {
+                // no longer needed
+                if(!dry) req.discard(*m_manager, true);
+                s.live -= m_ds_size;
+            } else {
+                possibly_compress(s, req, dry);
+            }
+
+            // allow inplace usage after degree reaches exactly one and
+            // data structure is not connected to CONSTRUCT
+            if(!dry && d == 1 && !req.requested) {
+                m_manager->unprotect(r);
+            }
+        }
+
+        possibly_compress(s, node, dry);
+    }
+
+    // runs the construction, returns the estimated memory peak
+    inline size_t run(size_t threads, size_t budget, bool dry) {
+        State s = initial_state();
+
+        if(!dry) {
+            for(auto& e : s.degree) {
+                // mark for protection if degree exceeds 1
+                if(e.second > 1) m_manager->protect(e.first);
+            }
+
+            if(m_cm == CompressMode::compressed) {
+                for(dsid_t ds : s.constructed) {
+                    m_nodes.at(ds).compress(*m_manager, true);
+                }
+            }
+        }
+
+        while(true) {
+            const auto batch = next_batch(s, threads, budget);
+            if(batch.empty()) break;
+
+            if(!dry) build(batch);
+
+            size_t overhead = 0;
+            for(const Node* node : batch) {
+                s.constructed.emplace(node->id);
+                overhead += node->overhead;
+            }
+            s.live += batch.size() * m_ds_size;
+            s.peak = std::max(s.peak, s.live + overhead);
+
+            for(const Node* node : batch) finish(s, *node, dry);
+        }
+
+        DCHECK_EQ(s.constructed.size(), m_nodes.size());
+        return s.peak;
+    }
+
+public:
+    /// \brief Constructs the requested data structures.
+    ///
+    /// \param manager the data structure manager instance
+    /// \param cm the compression mode to use
+    /// \param threads the maximum amount of data structures to construct
+    ///                concurrently
+    inline DSScheduler(manager_t& manager, const CompressMode cm, size_t threads)
+            : m_manager(&manager), m_cm(cm) {
+
+        const size_t n = manager.input.size();
+        m_ds_size = n * (cm == CompressMode::compressed
+            ? bits_for(n) : INDEX_BITS) / 8;
+
+        add_nodes(std::index_sequence<m_construct...>());
+
+        // the memory peak of a sequential construction is the budget
+        const size_t budget = run(1, SIZE_MAX, true);
+        run(std::max(threads, size_t(1)), budget, false);
+    }
+};
+
+} //ns
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <glog/logging.h>
+
+#include <tudocomp/ds/IntVector.hpp>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace tdc {
+
+/// \brief Block-wise access to bit-packed integer vectors.
+///
+/// Reading or writing a \ref DynamicIntVector element by element goes
+/// through a proxy that computes the word and offset of every single
+/// element. The functions in this namespace convert whole ranges of packed
+/// elements from and to plain 64-bit integers instead.
+///
+/// Elements are packed in LSBF order, i.e., the element starting at bit
+/// position \c p of the packed data starts at bit <tt>p % 64</tt> of
+/// word <tt>p / 64</tt> and continues in the following word if necessary.
+namespace bulk {
+
+/// The number of elements decoded at once by \ref Reader.
+constexpr size_t BLOCK_SIZE = 64;
+
+/// \cond INTERNAL
+inline constexpr uint64_t width_mask(uint8_t w) {
+    return (w >= 64) ? ~uint64_t(0) : ((uint64_t(1) << w) - 1);
+}
+
+inline void unpack_scalar(
+    const uint64_t* data, uint64_t bit_offset, uint8_t w,
+    size_t count, uint64_t* out) {
+
+    const uint64_t mask = width_mask(w);
+    for(size_t k = 0; k < count; k++) {
+        const uint64_t p = bit_offset + k * w;
+        const size_t i = p >> 6;
+        const uint8_t o = p & 63;
+
+        uint64_t v = data[i] >> o;
+        if(o + w > 64) v |= data[i + 1] << (64 - o);
+        out[k] = v & mask;
+    }
+}
+/// \endcond
+
+/// \brief Decodes consecutive packed elements.
+///
+/// Uses AVX2 gathers if available, processing four elements at a time.
+///
+/// \param data the packed data
+/// \param bit_offset the bit position of the first element in the data
+/// \param w the bit width of the elements (1 to 64)
+/// \param count the number of elements to decode
+/// \param out the array to store the decoded elements in
+inline void unpack(
+    const uint64_t* data, uint64_t bit_offset, uint8_t w,
+    size_t count, uint64_t* out) {
+
+    DCHECK(w > 0 && w <= 64) << "invalid bit width: " << size_t(w);
+    size_t k = 0;
+
+#ifdef __AVX2__
+    if(count >= 4) {
+        // the last word containing bits of the range, which must not be
+        // exceeded when gathering the successor words
+        const uint64_t last_word = (bit_offset + uint64_t(count) * w - 1) >> 6;
+
+        const __m256i mask = _mm256_set1_epi64x(width_mask(w));
+        const __m256i c63 = _mm256_set1_epi64x(63);
+        const __m256i c64 = _mm256_set1_epi64x(64);
+        const __m256i one = _mm256_set1_epi64x(1);
+        const __m256i step = _mm256_set1_epi64x(4 * uint64_t(w));
+        __m256i p = _mm256_add_epi64(_mm256_set1_epi64x(bit_offset),
+            _mm256_set_epi64x(3 * uint64_t(w), 2 * uint64_t(w), w, 0));
+
+        const long long* base = (const long long*)data;
+        for(; k + 4 <= count; k += 4) {
+            if(((bit_offset + (k + 3) * uint64_t(w)) >> 6) + 1 > last_word) break;
+
+            const __m256i idx = _mm256_srli_epi64(p, 6);
+            const __m256i sh = _mm256_and_si256(p, c63);
+
+            const __m256i lo = _mm256_i64gather_epi64(base, idx, 8);
+            const __m256i hi = _mm256_i64gather_epi64(base, _mm256_add_epi64(idx, one), 8);
+
+            // a shift by 64 yields zero, so elements within one word
+            // do not receive any bits of the successor word
+            const __m256i v = _mm256_or_si256(
+                _mm256_srlv_epi64(lo, sh),
+                _mm256_sllv_epi64(hi, _mm256_sub_epi64(c64, sh)));
+
+            _mm256_storeu_si256((__m256i*)(out + k), _mm256_and_si256(v, mask));
+            p = _mm256_add_epi64(p, step);
+        }
+    }
+#endif
+
+    unpack_scalar(data, bit_offset + uint64_t(k) * w, w, count - k, out + k);
+}
+
+/// \brief Encodes consecutive packed elements.
+///
+/// The bits of the data outside of the written range are preserved. Values
+/// are truncated to the given bit width.
+///
+/// \param in the values to encode
+/// \param count the number of values
+/// \param data the packed data
+/// \param bit_offset the bit position of the first element in the data
+/// \param w the bit width of the elements (1 to 64)
+inline void pack(
+    const uint64_t* in, size_t count,
+    uint64_t* data, uint64_t bit_offset, uint8_t w) {
+
+    DCHECK(w > 0 && w <= 64) << "invalid bit width: " << size_t(w);
+    if(count == 0) return;
+
+    const uint64_t mask = width_mask(w);
+
+    size_t i = bit_offset >> 6;
+    uint8_t o = bit_offset & 63;
+    uint64_t acc = data[i] & width_mask(o); // keep the bits before the range
+
+    for(size_t k = 0; k < count; k++) {
+        const uint64_t v = in[k] & mask;
+        acc |= v << o;
+        if(o + w >= 64) {
+            data[i++] = acc;
+            acc = (o + w > 64) ? (v >> (64 - o)) : 0;
+            o = o + w - 64;
+        } else {
+            o += w;
+        }
+    }
+
+    if(o > 0) {
+        // keep the bits after the range
+        data[i] = (data[i] & ~width_mask(o)) | acc;
+    }
+}
+
+/// \brief Decodes a range of a \ref DynamicIntVector.
+/// \param v the vector
+/// \param begin the index of the first element to decode
+/// \param count the number of elements to decode
+/// \param out the array to store the decoded elements in
+inline void unpack(const DynamicIntVector& v, size_t begin, size_t count, uint64_t* out) {
+    DCHECK_LE(begin + count, v.size());
+    unpack(v.data(), uint64_t(begin) * v.width(), v.width(), count, out);
+}
+
+/// \brief Encodes values into a range of a \ref DynamicIntVector.
+/// \param v the vector
+/// \param begin the index of the first element to write
+/// \param count the number of elements to write
+/// \param in the values to encode
+inline void pack(DynamicIntVector& v, size_t begin, size_t count, const uint64_t* in) {
+    DCHECK_LE(begin + count, v.size());
+    pack(in, count, v.data(), uint64_t(begin) * v.width(), v.width());
+}
+
+/// \brief Reads packed elements sequentially, decoding \ref BLOCK_SIZE
+///        elements at a time.
+///
+/// Supports range-based for loops:
+/// \code
+/// for(uint64_t x : bulk::Reader(sa)) { ... }
+/// \endcode
+class Reader {
+private:
+    const uint64_t* m_data;
+    uint64_t m_bit_offset;
+    uint8_t m_width;
+    size_t m_size;
+
+    size_t m_pos; // index of the next element
+    std::array<uint64_t, BLOCK_SIZE> m_block;
+
+    inline void fill() {
+        const size_t count = std::min(BLOCK_SIZE, m_size - m_pos);
+        unpack(m_data, m_bit_offset + uint64_t(m_pos) * m_width, m_width,
+            count, m_block.data());
+    }
+
+public:
+    class iterator {
+        Reader* m_reader;
+        size_t m_pos;
+        uint64_t m_value;
+
+    public:
+        inline iterator(Reader* reader, size_t pos, bool read)
+            : m_reader(reader), m_pos(pos), m_value(0) {
+            if(read && m_reader->has_next()) m_value = m_reader->next();
+        }
+
+        inline uint64_t operator*() const { return m_value; }
+
+        inline iterator& operator++() {
+            ++m_pos;
+            if(m_reader->has_next()) m_value = m_reader->next();
+            return *this;
+        }
+
+        inline bool operator!=(const iterator& other) const {
+            return m_pos != other.m_pos;
+        }
+    };
+
+    /// \brief Constructor.
+    /// \param data the packed data
+    /// \param bit_offset the bit position of the first element in the data
+    /// \param w the bit width of the elements
+    /// \param size the number of elements
+    inline Reader(const uint64_t* data, uint64_t bit_offset, uint8_t w, size_t size)
+        : m_data(data), m_bit_offset(bit_offset), m_width(w), m_size(size),
+          m_pos(0) {
+    }
+
+    /// \brief Reads the elements of a \ref DynamicIntVector, starting at
+    ///        the given index.
+    inline Reader(const DynamicIntVector& v, size_t begin = 0)
+        : Reader(v.data(), uint64_t(begin) * v.width(), v.width(),
+                 v.size() - begin) {
+        DCHECK_LE(begin, v.size());
+    }
+
+    /// \brief Tests whether there are more elements to read.
+    inline bool has_next() const {
+        return m_pos < m_size;
+    }
+
+    /// \brief Returns the next element.
+    inline uint64_t next() {
+        DCHECK(has_next());
+        if(m_pos % BLOCK_SIZE == 0) fill();
+        return m_block[m_pos++ % BLOCK_SIZE];
+    }
+
+    /// \brief Skips the next element.
+    inline void skip() {
+        DCHECK(has_next());
+        if(m_pos % BLOCK_SIZE == 0) fill();
+        ++m_pos;
+    }
+
+    inline iterator begin() { return iterator(this, m_pos, true); }
+    inline iterator end() { return iterator(this, m_size, false); }
+};
+
+/// \brief Writes packed elements sequentially, encoding \ref BLOCK_SIZE
+///        elements at a time.
+///
+/// Buffered elements are written when the block is full, when \ref flush is
+/// called and on destruction.
+class Writer {
+private:
+    uint64_t* m_data;
+    uint64_t m_bit_offset;
+    uint8_t m_width;
+
+    size_t m_pos; // the number of flushed elements
+    size_t m_fill;
+    std::array<uint64_t, BLOCK_SIZE> m_block;
+
+public:
+    /// \brief Constructor.
+    /// \param data the packed data
+    /// \param bit_offset the bit position of the first element in the data
+    /// \param w the bit width of the elements
+    inline Writer(uint64_t* data, uint64_t bit_offset, uint8_t w)
+        : m_data(data), m_bit_offset(bit_offset), m_width(w),
+          m_pos(0), m_fill(0) {
+    }
+
+    /// \brief Writes the elements of a \ref DynamicIntVector, starting at
+    ///        the given index.
+    ///
+    /// The vector must not be resized while the writer is in use.
+    inline Writer(DynamicIntVector& v, size_t begin = 0)
+        : Writer(v.data(), uint64_t(begin) * v.width(), v.width()) {
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    inline ~Writer() {
+        flush();
+    }
+
+    /// \brief Appends an element.
+    inline void push_back(uint64_t x) {
+        m_block[m_fill++] = x;
+        if(m_fill == BLOCK_SIZE) flush();
+    }
+
+    /// \brief Writes the buffered elements.
+    inline void flush() {
+        if(m_fill > 0) {
+            pack(m_block.data(), m_fill, m_data,
+                m_bit_offset + uint64_t(m_pos) * m_width, m_width);
+            m_pos += m_fill;
+            m_fill = 0;
+        }
+    }
+};
+
+}} //ns
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/util.hpp>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace tdc {
+
+/// \brief Longest common extension (LCE) of strings by direct comparison.
+///
+/// The strings are compared 32 bytes at a time if AVX2 is available, and
+/// eight bytes at a time otherwise.
+namespace lce {
+
+/// \brief Returns the length of the common prefix of the strings starting
+///        at \c a and \c b, but at most \c max.
+inline size_t forward(const uliteral_t* a, const uliteral_t* b, size_t max) {
+    size_t i = 0;
+#ifdef __AVX2__
+    for(; i + 32 <= max; i += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        const uint32_t neq = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if(neq) return i + __builtin_ctz(neq);
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for(; i + 8 <= max; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if(x != y) return i + __builtin_ctzll(x ^ y) / 8;
+    }
+#endif
+    while(i < max && a[i] == b[i]) ++i;
+    return i;
+}
+
+/// \brief Returns the length of the common suffix of the strings ending at
+///        \c a and \c b (exclusive), but at most \c max.
+inline size_t backward(const uliteral_t* a, const uliteral_t* b, size_t max) {
+    size_t i = 0;
+#ifdef __AVX2__
+    for(; i + 32 <= max; i += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a - i - 32));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b - i - 32));
+        const uint32_t neq = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if(neq) return i + __builtin_clz(neq);
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for(; i + 8 <= max; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a - i - 8, 8);
+        std::memcpy(&y, b - i - 8, 8);
+        if(x != y) return i + __builtin_clzll(x ^ y) / 8;
+    }
+#endif
+    while(i < max && a[-ptrdiff_t(i) - 1] == b[-ptrdiff_t(i) - 1]) ++i;
+    return i;
+}
+
+}
+
+} //ns
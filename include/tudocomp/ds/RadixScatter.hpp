@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/util.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace tdc {
+
+/// \brief Cache-blocked scattering of permutations.
+///
+/// Permutation inversions like <tt>isa[sa[i]] = i</tt> write to a random
+/// position for each element, so for large arrays, virtually every write
+/// is a cache (and TLB) miss.
+///
+/// The functions in this namespace receive the pairs of target positions
+/// and values from a generator and write them in two passes instead. First,
+/// the pairs are partitioned into buckets by the high bits of their target
+/// positions, so that the targets of each bucket form a range small enough
+/// to fit into the cache. Then, each bucket is written to its range.
+///
+/// A generator is a function <tt>gen(begin, end, emit)</tt> that calls
+/// <tt>emit(target, value)</tt> for the pairs \c begin to \c end - 1 in order.
+/// The targets of all \c n pairs must form a permutation of <tt>[0, n)</tt>.
+namespace radix_scatter {
+
+/// The minimum amount of elements for which the blocked scatter is used.
+constexpr size_t MIN_SIZE = size_t(1) << 20;
+
+/// The minimum amount of targets per bucket (as a power of two), such
+/// that a bucket's range of 64-bit values fills a typical L2 cache.
+constexpr uint8_t MIN_BUCKET_BITS = 15;
+
+/// The maximum amount of buckets (as a power of two), limited so the
+/// current cache lines of all buckets fit into the L1 and L2 cache during
+/// the partitioning.
+constexpr uint8_t MAX_FANOUT_BITS = 11;
+
+/// \brief Returns the amount of targets per bucket (as a power of two) for
+///        the given amount of elements.
+inline uint8_t bucket_bits_for(size_t n) {
+    const uint8_t log_n = bits_for(n);
+    return std::max(MIN_BUCKET_BITS,
+        uint8_t(log_n > MAX_FANOUT_BITS ? log_n - MAX_FANOUT_BITS : 0));
+}
+
+/// \brief Writes the generated values to their targets directly.
+/// \param out the vector to write to
+/// \param n the amount of elements
+/// \param gen the generator
+template<typename gen_t>
+inline void direct(DynamicIntVector& out, size_t n, gen_t gen) {
+    gen(size_t(0), n, [&](uint64_t target, uint64_t value){
+        out[target] = value;
+    });
+}
+
+/// \brief Writes the generated values to their targets bucket by bucket.
+///
+/// Additionally to the output, a buffer of \c n 64-bit words is allocated.
+/// If a value and its target offset within a bucket do not fit into a
+/// 64-bit word together, the values are written directly.
+///
+/// \param out the vector to write to
+/// \param n the amount of elements
+/// \param gen the generator
+/// \param bucket_bits the amount of targets per bucket (as a power of two)
+/// \param parallel whether to use multiple threads (requires OpenMP)
+template<typename gen_t>
+inline void blocked(
+    DynamicIntVector& out, size_t n, gen_t gen,
+    uint8_t bucket_bits, bool parallel) {
+
+    DCHECK_LE(n, out.size());
+    if(n == 0) return;
+
+    if(size_t(bits_for(n)) + bucket_bits > 64) {
+        direct(out, n, gen);
+        return;
+    }
+
+    const uint64_t offset_mask = (uint64_t(1) << bucket_bits) - 1;
+    const size_t num_buckets = ((n - 1) >> bucket_bits) + 1;
+
+    size_t num_threads = 1;
+    #ifdef ENABLE_OPENMP
+    if(parallel) {
+        num_threads = std::max(size_t(1), std::min(
+            size_t(omp_get_max_threads()), idiv_ceil(n, MIN_SIZE / 4)));
+    }
+    #endif
+
+    const size_t chunk = idiv_ceil(n, num_threads);
+
+    // the write position of each thread in each bucket
+    std::vector<std::vector<size_t>> pos(
+        num_threads, std::vector<size_t>(num_buckets, 0));
+
+    if(num_threads == 1) {
+        // the targets form a permutation, so the buckets are full
+        for(size_t b = 0; b < num_buckets; b++) pos[0][b] = b << bucket_bits;
+    } else {
+        // count the elements of each thread per bucket
+        #ifdef ENABLE_OPENMP
+        #pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+        #endif
+        for(ssize_t t = 0; t < ssize_t(num_threads); t++) {
+            auto& cnt = pos[t];
+            const size_t begin = std::min(n, t * chunk);
+            gen(begin, std::min(n, begin + chunk), [&](uint64_t target, uint64_t){
+                ++cnt[target >> bucket_bits];
+            });
+        }
+
+        // prefix sums
+        for(size_t b = 0, sum = 0; b < num_buckets; b++) {
+            for(size_t t = 0; t < num_threads; t++) {
+                const size_t c = pos[t][b];
+                pos[t][b] = sum;
+                sum += c;
+            }
+        }
+    }
+
+    // partition, each entry consists of the value and the target offset
+    // within the bucket
+    std::vector<uint64_t> buffer(n);
+
+    #ifdef ENABLE_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+    #endif
+    for(ssize_t t = 0; t < ssize_t(num_threads); t++) {
+        auto& p = pos[t];
+        const size_t begin = std::min(n, t * chunk);
+        gen(begin, std::min(n, begin + chunk), [&](uint64_t target, uint64_t value){
+            buffer[p[target >> bucket_bits]++] =
+                (value << bucket_bits) | (target & offset_mask);
+        });
+    }
+    pos.clear();
+
+    // scatter each bucket within its range, which starts at a word boundary
+    // of the output if the buckets are large enough
+    const bool aligned =
+        ((uint64_t(1) << bucket_bits) * out.width()) % 64 == 0;
+
+    #ifdef ENABLE_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1) if(aligned)
+    #endif
+    for(ssize_t b = 0; b < ssize_t(num_buckets); b++) {
+        const size_t base = size_t(b) << bucket_bits;
+        const size_t end = std::min(n, base + (size_t(1) << bucket_bits));
+        for(size_t k = base; k < end; k++) {
+            const uint64_t e = buffer[k];
+            out[base | (e & offset_mask)] = e >> bucket_bits;
+        }
+    }
+}
+
+/// \brief Returns the size in bytes of the buffer that \ref scatter
+///        allocates temporarily for the given amount of elements.
+inline size_t buffer_size(size_t n) {
+    return (n < MIN_SIZE) ? 0 : n * sizeof(uint64_t);
+}
+
+/// \brief Writes the generated values to their targets, using the blocked
+///        scatter for large inputs.
+///
+/// \param out the vector to write to
+/// \param n the amount of elements
+/// \param gen the generator
+/// \param parallel whether to use multiple threads (requires OpenMP)
+template<typename gen_t>
+inline void scatter(DynamicIntVector& out, size_t n, gen_t gen, bool parallel) {
+    if(n < MIN_SIZE) {
+        direct(out, n, gen);
+    } else {
+        blocked(out, n, gen, bucket_bits_for(n), parallel);
+    }
+}
+
+}} //ns
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <tudocomp/util.hpp>
+#include <tudocomp/ds/rank_64bit.hpp>
+#include <tudocomp/ds/select_64bit.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace tdc {
+
+/// \brief Implements a combined rank and select data structure for a
+///        \ref BitVector.
+///
+/// The bit vector is split into blocks of 512 bits. Each block is stored
+/// together with its counters (the rank9 layout), so the data and the
+/// counters needed for a query are adjacent in memory:
+///
+/// - the amount of 1-bits before the block (64 bits),
+/// - the amount of 1-bits before each of the block's words 1 to 7, relative
+///   to the block (7 times 9 bits),
+/// - the block's eight 64-bit data words.
+///
+/// A block takes 80 bytes and is not aligned to cache lines, so the counters
+/// and the data word read by a rank query lie in one or two cache lines.
+/// Padding the blocks to 128 bytes makes the structure twice as large
+/// without saving cache misses.
+///
+/// Select queries are narrowed down using the blocks containing every
+/// \ref select_sample_rate-th 0-bit and 1-bit, respectively.
+///
+/// In contrast to \ref Rank and \ref Select, the bit vector is copied, so it
+/// may be modified or destroyed after construction.
+class RankSelect {
+public:
+    /// The size of a block in bits.
+    static constexpr size_t block_size = 512;
+
+    /// Every how many 0-bits and 1-bits a select hint is stored.
+    static constexpr size_t select_sample_rate = 2048;
+
+    /// The minimum size of a bit vector (in bits) for which the
+    /// construction uses multiple threads.
+    static constexpr size_t parallel_min = size_t(1) << 24;
+
+private:
+    static constexpr size_t block_words = block_size / 64;
+    static constexpr size_t stride = block_words + 2; // 80 bytes
+
+    // the amount of blocks up to which select scans linearly
+    static constexpr size_t linear_max = 8;
+
+    size_t m_size;
+    size_t m_num_blocks;
+    size_t m_ones;
+
+    std::vector<uint64_t> m_blocks;
+
+    std::vector<size_t> m_hints0;
+    std::vector<size_t> m_hints1;
+
+    /// the amount of 1-bits before block b
+    inline uint64_t ones_before(size_t b) const {
+        return m_blocks[b * stride];
+    }
+
+    /// the amount of m_bit-bits before block b
+    template<bool m_bit>
+    inline uint64_t count_before(size_t b) const {
+        return m_bit ? ones_before(b) : b * block_size - ones_before(b);
+    }
+
+    /// the amount of 1-bits before word j within block b
+    inline size_t ones_before_word(size_t b, size_t j) const {
+        const uint64_t sub = m_blocks[b * stride + 1];
+        return j ? ((sub >> (9 * (j - 1))) & 0x1FFULL) : 0;
+    }
+
+    inline const uint64_t* words(size_t b) const {
+        return m_blocks.data() + b * stride + 2;
+    }
+
+    /// Copies the given block's data and fills in its relative counters.
+    /// Returns the amount of 1-bits in the block.
+    inline size_t fill_block(const uint64_t* data, size_t num_data, size_t b) {
+        uint64_t* block = m_blocks.data() + b * stride;
+        uint64_t sub = 0;
+        size_t r = 0;
+
+        for(size_t j = 0; j < block_words; j++) {
+            const size_t k = b * block_words + j;
+
+            uint64_t w = 0;
+            if(k < num_data) {
+                w = data[k];
+                if(k + 1 == num_data && m_size % 64) {
+                    // clear unused bits of the last word
+                    w &= (uint64_t(1) << (m_size % 64)) - 1;
+                }
+            }
+
+            if(j > 0) sub |= uint64_t(r) << (9 * (j - 1));
+            block[2 + j] = w;
+            r += tdc::rank1(w);
+        }
+
+        block[1] = sub;
+        return r;
+    }
+
+    template<bool m_bit>
+    inline void sample(std::vector<size_t>& hints) const {
+        hints.clear();
+        size_t next = 1; // the order of the next sampled bit
+        for(size_t b = 0; b < m_num_blocks; b++) {
+            const size_t end = count_before<m_bit>(b + 1);
+            while(next <= end) {
+                hints.push_back(b);
+                next += select_sample_rate;
+            }
+        }
+        hints.push_back(m_num_blocks);
+    }
+
+    /// the position of the k-th m_bit-bit within word v
+    template<bool m_bit>
+    inline static uint8_t select_word(uint64_t v, size_t k) {
+        return select1_word(m_bit ? v : ~v, k);
+    }
+
+    template<bool m_bit>
+    inline size_t select(size_t k) const {
+        DCHECK_GT(k, 0U) << "order must be at least one";
+        const size_t max = m_bit ? m_ones : m_size - m_ones;
+        if(k > max) return m_size;
+
+        const auto& hints = m_bit ? m_hints1 : m_hints0;
+
+        // find the block containing the bit, i.e., the last block before
+        // which there are less than k flagged bits
+        const size_t h = (k - 1) / select_sample_rate;
+        size_t lo = hints[h];
+        size_t hi = std::min(hints[h + 1] + 1, m_num_blocks);
+        while(hi - lo > linear_max) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if(count_before<m_bit>(mid) < k) lo = mid;
+            else hi = mid;
+        }
+        while(lo + 1 < hi && count_before<m_bit>(lo + 1) < k) ++lo;
+
+        const size_t b = lo;
+        k -= count_before<m_bit>(b);
+
+        // find the word containing the bit
+        size_t j = 0;
+        while(j + 1 < block_words) {
+            const size_t before = m_bit
+                ? ones_before_word(b, j + 1)
+                : 64 * (j + 1) - ones_before_word(b, j + 1);
+            if(before >= k) break;
+            ++j;
+        }
+        k -= m_bit ? ones_before_word(b, j) : 64 * j - ones_before_word(b, j);
+
+        return b * block_size + 64 * j + select_word<m_bit>(words(b)[j], k);
+    }
+
+public:
+    /// \brief Default constructor.
+    inline RankSelect() : m_size(0), m_num_blocks(0), m_ones(0) {
+    }
+
+    /// \brief Constructs the rank and select data structure for the given
+    ///        bit vector.
+    ///
+    /// Large bit vectors are processed in parallel if OpenMP is enabled.
+    ///
+    /// \param bv the bit vector
+    inline RankSelect(const BitVector& bv)
+        : m_size(bv.size()),
+          m_num_blocks(idiv_ceil(bv.size(), block_size)),
+          m_ones(0) {
+
+        const auto data = bv.data();
+        const size_t num_data = idiv_ceil(m_size, 64);
+
+        // an additional block stores the total amount of 1-bits
+        m_blocks.resize((m_num_blocks + 1) * stride, 0);
+
+        // copy data and compute relative counters, the amount of 1-bits
+        // per block is temporarily stored in place of the absolute counter
+        const ssize_t num_blocks = m_num_blocks;
+
+        #ifdef ENABLE_OPENMP
+        #pragma omp parallel for schedule(static) if(m_size >= parallel_min)
+        #endif
+        for(ssize_t b = 0; b < num_blocks; b++) {
+            m_blocks[b * stride] = fill_block(data, num_data, b);
+        }
+
+        // prefix sums
+        for(size_t b = 0; b < m_num_blocks; b++) {
+            const size_t r = m_blocks[b * stride];
+            m_blocks[b * stride] = m_ones;
+            m_ones += r;
+        }
+        m_blocks[m_num_blocks * stride] = m_ones;
+
+        // select hints
+        #ifdef ENABLE_OPENMP
+        #pragma omp parallel sections if(m_size >= parallel_min)
+        #endif
+        {
+            #ifdef ENABLE_OPENMP
+            #pragma omp section
+            #endif
+            sample<0>(m_hints0);
+            #ifdef ENABLE_OPENMP
+            #pragma omp section
+            #endif
+            sample<1>(m_hints1);
+        }
+    }
+
+    /// \brief Returns the size of the underlying bit vector.
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// \brief Returns the value of the bit at the given position.
+    inline bool operator[](size_t x) const {
+        DCHECK_LT(x, m_size);
+        return (words(x / block_size)[(x % block_size) / 64] >> (x % 64)) & 1ULL;
+    }
+
+    /// \brief Counts the amount of 1-bits from the beginning of the bit vector
+    ///        up to (including) the given position.
+    /// \param x the position up to which to count (inclusively)
+    /// \return the amount of counted 1-bits
+    inline size_t rank1(size_t x) const {
+        DCHECK_LT(x, m_size);
+        const size_t b = x / block_size;
+        const size_t j = (x % block_size) / 64;
+
+        // the mask overflows to all bits set for the most significant bit
+        const uint64_t mask = (uint64_t(2) << (x % 64)) - 1;
+        return ones_before(b) + ones_before_word(b, j)
+            + tdc::rank1(uint64_t(words(b)[j] & mask));
+    }
+
+    /// \brief Counts the amount of 1-bits in the given interval (borders
+    ///        included) of the bit vector.
+    /// \param x the position from which to start counting (inclusively)
+    /// \param y the position at which to stop counting (inclusively)
+    /// \return the amount of counted 1-bits
+    inline size_t rank1(size_t x, size_t y) const {
+        DCHECK_LE(x, y);
+        size_t r = rank1(y);
+        if(x > 0) r -= rank1(x-1);
+        return r;
+    }
+
+    /// \see rank1
+    inline size_t operator()(size_t x) const {
+        return rank1(x);
+    }
+
+    /// \see rank1
+    inline size_t operator()(size_t x, size_t y) const {
+        return rank1(x, y);
+    }
+
+    /// \brief Counts the amount of 0-bits from the beginning of the bit vector
+    ///        up to (including) the given position.
+    /// \param x the position up to which to count (inclusively)
+    /// \return the amount of counted 0-bits
+    inline size_t rank0(size_t x) const {
+        return x + 1 - rank1(x);
+    }
+
+    /// \brief Counts the amount of 0-bits in the given interval (borders
+    ///        included) of the bit vector.
+    /// \param x the position from which to start counting (inclusively)
+    /// \param y the position at which to stop counting (inclusively)
+    /// \return the amount of counted 0-bits
+    inline size_t rank0(size_t x, size_t y) const {
+        return (y - x + 1) - rank1(x, y);
+    }
+
+    /// \brief Finds the position of the k-th 1-bit in the bit vector.
+    /// \param k the order of the 1-bit to find
+    /// \return the position of the k-th 1-bit. In case the position is
+    ///         not contained in the bit vector, the bit vector's size is
+    ///         returned.
+    inline size_t select1(size_t k) const {
+        return select<1>(k);
+    }
+
+    /// \brief Finds the position of the k-th 0-bit in the bit vector.
+    /// \param k the order of the 0-bit to find
+    /// \return the position of the k-th 0-bit. In case the position is
+    ///         not contained in the bit vector, the bit vector's size is
+    ///         returned.
+    inline size_t select0(size_t k) const {
+        return select<0>(k);
+    }
+};
+
+}
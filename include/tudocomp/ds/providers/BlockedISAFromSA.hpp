@@ -0,0 +1,105 @@
+#pragma once
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/DSDef.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
+#include <tudocomp/ds/RadixScatter.hpp>
+
+#include <tudocomp/util.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the inverse suffix array from the suffix array.
+///
+/// In contrast to \ref ISAFromSA, the entries are written in a cache-blocked
+/// manner for large inputs (see \ref radix_scatter), which temporarily
+/// requires an additional 64-bit word per entry.
+class BlockedISAFromSA : public Algorithm {
+public:
+    inline static Meta meta() {
+        Meta m(ds::provider_type(), "blocked_isa");
+        m.param("parallel", "Use multiple threads (requires OpenMP).")
+            .primitive(true);
+        return m;
+    }
+
+private:
+    DynamicIntVector m_isa;
+
+public:
+    using Algorithm::Algorithm;
+
+    using provides = std::index_sequence<ds::INVERSE_SUFFIX_ARRAY>;
+    using requires = std::index_sequence<ds::SUFFIX_ARRAY>;
+    using ds_types = tl::set<ds::INVERSE_SUFFIX_ARRAY, decltype(m_isa)>;
+
+    /// The temporary memory in bytes needed for the construction, in
+    /// addition to the data structure itself (see \ref DSScheduler).
+    inline static size_t construction_overhead(size_t n) {
+        return radix_scatter::buffer_size(n);
+    }
+
+    // implements concept "DSProvider"
+    template<typename manager_t>
+    inline void construct(manager_t& manager, bool compressed_space) {
+        // get suffix array
+        auto& sa = manager.template get<ds::SUFFIX_ARRAY>();
+
+        StatPhase::wrap("Construct ISA", [&]{
+            // Allocate
+            const size_t n = manager.input.size();
+            const size_t w = bits_for(n);
+
+            m_isa = DynamicIntVector(n, 0, compressed_space ? w : INDEX_BITS);
+
+            // Construct
+            radix_scatter::scatter(m_isa, n,
+                [&](size_t begin, size_t end, auto emit){
+                    bulk::Reader sa_reader(sa, begin);
+                    for(size_t i = begin; i < end; i++) {
+                        emit(sa_reader.next(), i);
+                    }
+                }, config().param("parallel").as_bool());
+
+            StatPhase::log("bit_width", size_t(m_isa.width()));
+            StatPhase::log("size", m_isa.bit_size() / 8);
+        });
+    }
+
+    // implements concept "DSProvider"
+    template<dsid_t ds> void compress();
+    template<dsid_t ds> void discard();
+    template<dsid_t ds> const tl::get<ds, ds_types>& get() const;
+    template<dsid_t ds> tl::get<ds, ds_types> relinquish();
+};
+
+template<>
+inline void BlockedISAFromSA::discard<ds::INVERSE_SUFFIX_ARRAY>() {
+    m_isa.clear();
+    m_isa.shrink_to_fit();
+}
+
+template<>
+inline void BlockedISAFromSA::compress<ds::INVERSE_SUFFIX_ARRAY>() {
+    StatPhase::wrap("Compress ISA", [this]{
+        m_isa.width(bits_for(m_isa.size()));
+        m_isa.shrink_to_fit();
+
+        StatPhase::log("bit_width", size_t(m_isa.width()));
+        StatPhase::log("size", m_isa.bit_size() / 8);
+    });
+}
+
+template<>
+inline const DynamicIntVector& BlockedISAFromSA::get<ds::INVERSE_SUFFIX_ARRAY>() const {
+    return m_isa;
+}
+
+template<>
+inline DynamicIntVector BlockedISAFromSA::relinquish<ds::INVERSE_SUFFIX_ARRAY>() {
+    return std::move(m_isa);
+}
+
+} //ns
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/DSDef.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
+#include <tudocomp/ds/RadixScatter.hpp>
+
+#include <tudocomp/util.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the Phi array from the suffix array.
+///
+/// In contrast to \ref PhiFromSA, the entries are written in a cache-blocked
+/// manner for large inputs (see \ref radix_scatter), which temporarily
+/// requires an additional 64-bit word per entry.
+///
+/// The entry of the lexicographically smallest suffix, which has no
+/// predecessor, is set to the length of the input.
+class BlockedPhiFromSA : public Algorithm {
+public:
+    inline static Meta meta() {
+        Meta m(ds::provider_type(), "blocked_phi");
+        m.param("parallel", "Use multiple threads (requires OpenMP).")
+            .primitive(true);
+        return m;
+    }
+
+private:
+    DynamicIntVector m_phi;
+
+public:
+    using Algorithm::Algorithm;
+
+    using provides = std::index_sequence<ds::PHI_ARRAY>;
+    using requires = std::index_sequence<ds::SUFFIX_ARRAY>;
+    using ds_types = tl::set<ds::PHI_ARRAY, decltype(m_phi)>;
+
+    /// The temporary memory in bytes needed for the construction, in
+    /// addition to the data structure itself (see \ref DSScheduler).
+    inline static size_t construction_overhead(size_t n) {
+        return radix_scatter::buffer_size(n);
+    }
+
+    // implements concept "DSProvider"
+    template<typename manager_t>
+    inline void construct(manager_t& manager, bool compressed_space) {
+        // get suffix array
+        auto& sa = manager.template get<ds::SUFFIX_ARRAY>();
+
+        const size_t n = manager.input.size();
+        const size_t w = bits_for(n);
+
+        StatPhase::wrap("Construct Phi Array", [&]{
+            // Construct Phi Array
+            m_phi = DynamicIntVector(n, 0, compressed_space ? w : INDEX_BITS);
+
+            radix_scatter::scatter(m_phi, n,
+                [&](size_t begin, size_t end, auto emit){
+                    // the smallest suffix has no predecessor
+                    len_t prev = (begin > 0) ? len_t(sa[begin - 1]) : len_t(n);
+
+                    bulk::Reader sa_reader(sa, begin);
+                    for(size_t i = begin; i < end; i++) {
+                        const len_t cur = sa_reader.next();
+                        emit(cur, prev);
+                        prev = cur;
+                    }
+                }, config().param("parallel").as_bool());
+
+            StatPhase::log("bit_width", size_t(m_phi.width()));
+            StatPhase::log("size", m_phi.bit_size() / 8);
+        });
+    }
+
+    // implements concept "DSProvider"
+    template<dsid_t ds> void compress();
+    template<dsid_t ds> void discard();
+    template<dsid_t ds> const tl::get<ds, ds_types>& get() const;
+    template<dsid_t ds> tl::get<ds, ds_types> relinquish();
+};
+
+template<>
+inline void BlockedPhiFromSA::discard<ds::PHI_ARRAY>() {
+    m_phi.clear();
+    m_phi.shrink_to_fit();
+}
+
+template<>
+inline void BlockedPhiFromSA::compress<ds::PHI_ARRAY>() {
+    StatPhase::wrap("Compress Phi Array", [this]{
+        m_phi.width(bits_for(m_phi.size()));
+        m_phi.shrink_to_fit();
+
+        StatPhase::log("bit_width", size_t(m_phi.width()));
+        StatPhase::log("size", m_phi.bit_size() / 8);
+    });
+}
+
+template<>
+inline const DynamicIntVector& BlockedPhiFromSA::get<ds::PHI_ARRAY>() const {
+    return m_phi;
+}
+
+template<>
+inline DynamicIntVector BlockedPhiFromSA::relinquish<ds::PHI_ARRAY>() {
+    return std::move(m_phi);
+}
+
+} //ns
@@ -3,6 +3,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
 
 #include <tudocomp/util.hpp>
 #include <tudocomp_stat/StatPhase.hpp>
@@ -41,8 +42,9 @@ public:
             m_isa = DynamicIntVector(n, 0, compressed_space ? w : INDEX_BITS);
 
             // Construct
-            for(len_t i = 0; i < n; i++) {
-                m_isa[sa[i]] = i;
+            len_t i = 0;
+            for(uint64_t s : bulk::Reader(sa)) {
+                m_isa[s] = i++;
             }
 
             StatPhase::log("bit_width", size_t(m_isa.width()));
@@ -3,6 +3,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
 
 #include <tudocomp/util.hpp>
 #include <tudocomp_stat/StatPhase.hpp>
@@ -45,10 +46,13 @@ public:
             m_lcp = DynamicIntVector(
                 n, 0, compressed_space ? bits_for(m_max_lcp) : INDEX_BITS);
 
-            m_lcp[0] = 0;
-            for(len_t i = 1; i < n; i++) {
-                const len_t x = plcp[sa[i]];
-                m_lcp[i] = x;
+            if(n > 0) {
+                m_lcp[0] = 0;
+                bulk::Reader sa_reader(sa, 1);
+                bulk::Writer lcp_writer(m_lcp, 1);
+                for(len_t i = 1; i < n; i++) {
+                    lcp_writer.push_back(plcp[sa_reader.next()]);
+                }
             }
 
             StatPhase::log("bit_width", size_t(m_lcp.width()));
@@ -3,6 +3,8 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
+#include <tudocomp/ds/LCE.hpp>
 
 #include <tudocomp/util.hpp>
 #include <tudocomp_stat/StatPhase.hpp>
@@ -10,6 +12,8 @@
 namespace tdc {
 
 /// Constructs the PLCP array using the Phi array.
+///
+/// The input does not need to be terminated by a sentinel.
 class PhiAlgorithm : public Algorithm {
 public:
     inline static Meta meta() {
@@ -39,13 +43,27 @@ public:
 
         StatPhase::wrap("Construct PLCP", [&]{
             // Use Phi algorithm to compute PLCP array
+            // (the writer trails the reader, so Phi can be overwritten)
             m_max_lcp = 0;
-            for(len_t i = 0, l = 0; i < n - 1; ++i) {
-                const len_t phi_i = m_plcp[i];
-                while(t[i + l] == t[phi_i + l]) ++l;
-                m_max_lcp = std::max(m_max_lcp, l);
-                m_plcp[i] = l;
-                if(l) --l;
+            {
+                bulk::Reader phi(m_plcp);
+                bulk::Writer plcp(m_plcp);
+                for(len_t i = 0, l = 0; i < n; ++i) {
+                    const len_t phi_i = phi.next();
+                    if(phi_i == n) {
+                        // the smallest suffix has no predecessor
+                        l = 0;
+                    } else {
+                        // the end of the text is handled virtually, so no
+                        // sentinel is needed to stop the comparison
+                        const len_t max_l = n - std::max(i, phi_i);
+                        l += lce::forward(
+                            t.data() + i + l, t.data() + phi_i + l, max_l - l);
+                    }
+                    m_max_lcp = std::max(m_max_lcp, l);
+                    plcp.push_back(l);
+                    if(l) --l;
+                }
             }
 
             StatPhase::log("bit_width", size_t(m_plcp.width()));
@@ -3,6 +3,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
 
 #include <tudocomp/util.hpp>
 #include <tudocomp_stat/StatPhase.hpp>
@@ -10,6 +11,9 @@
 namespace tdc {
 
 /// Constructs the Phi array from the suffix array.
+///
+/// The entry of the lexicographically smallest suffix, which has no
+/// predecessor, is set to the length of the input.
 class PhiFromSA : public Algorithm {
 public:
     inline static Meta meta() {
@@ -40,11 +44,16 @@ public:
             // Construct Phi Array
             m_phi = DynamicIntVector(n, 0, compressed_space ? w : INDEX_BITS);
 
-            for(len_t i = 1, prev = sa[0]; i < n; i++) {
-                m_phi[sa[i]] = prev;
-                prev = sa[i];
+            if(n > 0) {
+                bulk::Reader sa_reader(sa);
+                for(len_t i = 1, prev = sa_reader.next(); i < n; i++) {
+                    const len_t cur = sa_reader.next();
+                    m_phi[cur] = prev;
+                    prev = cur;
+                }
+                // the smallest suffix has no predecessor
+                m_phi[sa[0]] = n;
             }
-            m_phi[sa[0]] = sa[n-1];
 
             StatPhase::log("bit_width", size_t(m_phi.width()));
             StatPhase::log("size", m_phi.bit_size() / 8);
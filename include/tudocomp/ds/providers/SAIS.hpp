@@ -0,0 +1,92 @@
+#pragma once
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/DSDef.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+
+#include <tudocomp/util/sais.hpp>
+#include <tudocomp/util.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the suffix array using SA-IS.
+///
+/// In contrast to \ref DivSufSort, the input does not need to be terminated
+/// by a sentinel, so binary inputs can be processed without escaping.
+/// Also, no additional bit is needed during construction, so in compressed
+/// space mode, the suffix array is constructed with its final bit width
+/// right away.
+class SAIS : public Algorithm {
+public:
+    inline static Meta meta() {
+        Meta m(ds::provider_type(), "sais");
+        return m;
+    }
+
+private:
+    DynamicIntVector m_sa;
+
+public:
+    using Algorithm::Algorithm;
+
+    using sa_t = decltype(m_sa);
+
+    using provides = std::index_sequence<ds::SUFFIX_ARRAY>;
+    using requires = std::index_sequence<>;
+    using ds_types = tl::set<ds::SUFFIX_ARRAY, sa_t>;
+
+    // implements concept "DSProvider"
+    template<typename manager_t>
+    inline void construct(manager_t& manager, bool compressed_space) {
+        StatPhase::wrap("Construct SA", [&]{
+            // Allocate
+            const size_t n = manager.input.size();
+            const size_t w = bits_for(n);
+
+            m_sa = DynamicIntVector(n, 0, compressed_space ? w : INDEX_BITS);
+
+            // Use SA-IS to construct
+            sais(manager.input, m_sa, n, ULITERAL_MAX + 1);
+
+            StatPhase::log("bit_width", size_t(m_sa.width()));
+            StatPhase::log("size", m_sa.bit_size() / 8);
+        });
+    }
+
+    // implements concept "DSProvider"
+    template<dsid_t ds> void compress();
+    template<dsid_t ds> void discard();
+    template<dsid_t ds> const tl::get<ds, ds_types>& get() const;
+    template<dsid_t ds> tl::get<ds, ds_types> relinquish();
+};
+
+template<>
+inline void SAIS::discard<ds::SUFFIX_ARRAY>() {
+    m_sa.clear();
+    m_sa.shrink_to_fit();
+}
+
+template<>
+inline void SAIS::compress<ds::SUFFIX_ARRAY>() {
+    StatPhase::wrap("Compress SA", [this]{
+        m_sa.width(bits_for(m_sa.size()));
+        m_sa.shrink_to_fit();
+
+        StatPhase::log("bit_width", size_t(m_sa.width()));
+        StatPhase::log("size", m_sa.bit_size() / 8);
+    });
+}
+
+template<>
+inline const SAIS::sa_t& SAIS::get<ds::SUFFIX_ARRAY>() const {
+    return m_sa;
+}
+
+template<>
+inline SAIS::sa_t SAIS::relinquish<ds::SUFFIX_ARRAY>() {
+    return std::move(m_sa);
+}
+
+} //ns
@@ -6,7 +6,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/DSDef.hpp>
 #include <tudocomp/ds/IntVector.hpp>
-#include <tudocomp/ds/Rank.hpp>
+#include <tudocomp/ds/RankSelect.hpp>
 
 #include <tudocomp/util.hpp>
 #include <tudocomp_stat/StatPhase.hpp>
@@ -33,8 +33,7 @@ public:
     private:
         const sa_t* m_sa;
 
-        BitVector m_has_shortcut;
-        Rank      m_rank;
+        RankSelect m_rank; // marks the positions that have a shortcut
 
         DynamicIntVector m_shortcuts;
 
@@ -44,7 +43,6 @@ public:
     public:
         inline Data(Data&& other)
             : m_sa(other.m_sa),
-              m_has_shortcut(std::move(other.m_has_shortcut)),
               m_rank(std::move(other.m_rank)),
               m_shortcuts(std::move(other.m_shortcuts))
         {
@@ -52,7 +50,6 @@ public:
 
         inline Data(const Data& other)
             : m_sa(other.m_sa),
-              m_has_shortcut(other.m_has_shortcut),
               m_rank(other.m_rank),
               m_shortcuts(other.m_shortcuts)
         {
@@ -60,17 +57,15 @@ public:
 
         inline Data& operator=(Data&& other) {
             m_sa = other.m_sa;
-            m_has_shortcut = std::move(other.m_has_shortcut);
-            m_rank         = std::move(other.m_rank);
-            m_shortcuts    = std::move(other.m_shortcuts);
+            m_rank      = std::move(other.m_rank);
+            m_shortcuts = std::move(other.m_shortcuts);
             return *this;
         }
 
         inline Data& operator=(const Data& other) {
             m_sa = other.m_sa;
-            m_has_shortcut = other.m_has_shortcut;
-            m_rank         = other.m_rank;
-            m_shortcuts    = other.m_shortcuts;
+            m_rank      = other.m_rank;
+            m_shortcuts = other.m_shortcuts;
             return *this;
         }
 
@@ -80,7 +75,7 @@ public:
             bool s = true;
 
             while((*m_sa)[j] != i) {
-                if(s && m_has_shortcut[j]) {
+                if(s && m_rank[j]) {
                     j = m_shortcuts[m_rank(j)-1];
                     s = false;
                 } else {
@@ -92,7 +87,7 @@ public:
 
         // size
         inline size_t size() const {
-            return m_has_shortcut.size();
+            return m_rank.size();
         }
     };
 
@@ -114,35 +109,39 @@ public:
         m_data.m_sa = &sa;
 
         const size_t n = sa.size();
-        m_data.m_has_shortcut = BitVector(n);
 
         const size_t t = this->config().param("t").as_uint();
 
         // Construct
         StatPhase::wrap("Construct sparse ISA", [&]{
             auto v = BitVector(n);
-            for(size_t i = 0; i < n; i++) {
-                if(!v[i]) {
-                    // new cycle
-                    v[i] = 1;
-                    size_t j = sa[i];
-                    size_t k = 1;
-
-                    while(j != i) {
-                        if((k % t) == 0) {
-                            m_data.m_has_shortcut[j] = 1;
+            {
+                // the rank data structure keeps its own copy of the bits
+                auto has_shortcut = BitVector(n);
+                for(size_t i = 0; i < n; i++) {
+                    if(!v[i]) {
+                        // new cycle
+                        v[i] = 1;
+                        size_t j = sa[i];
+                        size_t k = 1;
+
+                        while(j != i) {
+                            if((k % t) == 0) {
+                                has_shortcut[j] = 1;
+                            }
+
+                            v[j] = 1;
+                            j = sa[j];
+                            ++k;
                         }
 
-                        v[j] = 1;
-                        j = sa[j];
-                        ++k;
+                        if(k > t) has_shortcut[i] = 1;
                     }
-
-                    if(k > t) m_data.m_has_shortcut[i] = 1;
                 }
+
+                m_data.m_rank = RankSelect(has_shortcut);
             }
 
-            m_data.m_rank = Rank(m_data.m_has_shortcut);
             m_data.m_shortcuts = DynamicIntVector(
                 m_data.m_rank(n-1), 0, bits_for(n));
 
@@ -151,7 +150,7 @@ public:
                     v[i] = 0;
                     size_t j = sa[i];
                     while(v[j]) {
-                        if(m_data.m_has_shortcut[j]) {
+                        if(m_data.m_rank[j]) {
                             m_data.m_shortcuts[m_data.m_rank(j)-1] = i;
                             i = j;
                         }
@@ -159,7 +158,7 @@ public:
                         j = sa[j];
                     }
 
-                    if(m_data.m_has_shortcut[j]) {
+                    if(m_data.m_rank[j]) {
                         m_data.m_shortcuts[m_data.m_rank(j)-1] = i;
                     }
 
@@ -2,6 +2,11 @@
 
 #include <cstdint>
 #include <tudocomp/util.hpp>
+#include <tudocomp/ds/rank_64bit.hpp>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
 
 namespace tdc {
 
@@ -51,6 +56,30 @@ inline constexpr uint8_t select1(uint_t v, uint8_t l, uint8_t k) {
     return (pos != SELECT_FAIL) ? (l + pos) : SELECT_FAIL;
 }
 
+/// \brief Finds the position of the k-th 1-bit in a 64-bit value, which
+///        must contain at least \c k 1-bits.
+///
+/// Uses the \c pdep instruction if available (BMI2), otherwise the byte
+/// containing the bit is found using population counts.
+///
+/// \param v the input value
+/// \param k the searched 1-bit
+/// \return the position of the k-th 1-bit (LSBF and zero-based)
+inline uint8_t select1_word(uint64_t v, uint8_t k) {
+    DCHECK(k > 0 && k <= rank1(v)) << "k=" << size_t(k);
+#ifdef __BMI2__
+    return __builtin_ctzll(_pdep_u64(uint64_t(1) << (k - 1), v));
+#else
+    uint8_t shift = 0;
+    uint8_t r;
+    while(k > (r = rank1(uint8_t(v >> shift)))) {
+        k -= r;
+        shift += 8;
+    }
+    return shift + select1(uint8_t(v >> shift), k);
+#endif
+}
+
 /// \brief Finds the position of the k-th 0-bit in the binary representation
 ///        of the given value.
 ///
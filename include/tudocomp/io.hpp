@@ -25,5 +25,8 @@ using BitIStream = io::BitIStream;
 /// Convenience shortcut to \ref io::BitOStream.
 using BitOStream = io::BitOStream;
 
+/// Convenience shortcut to \ref io::BitPacker.
+using BitPacker = io::BitPacker;
+
 }
 
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <tudocomp/io/IOUtil.hpp>
+
+namespace tdc {
+namespace io {
+
+/// \cond INTERNAL
+
+/// Stream buffer for file output that overlaps writing to disk with the
+/// computation producing the data.
+///
+/// The data is collected in one of two large aligned buffers. Once it is
+/// full, it is handed to a background thread that writes it to the file,
+/// while the other buffer is being filled. The thread is only started and
+/// the large buffers are only allocated once a small first buffer runs
+/// full, so small outputs are written directly.
+///
+/// For large outputs, the written pages are dropped from the page cache
+/// (`posix_fadvise(DONTNEED)`) so the archive does not evict the input.
+/// Optionally, the file is written with `O_DIRECT`, bypassing the page
+/// cache entirely.
+class AsyncFileStreamBuffer : public std::streambuf {
+public:
+    static constexpr size_t ALIGNMENT = 4096;
+    static constexpr size_t DEFAULT_BUFFER_SIZE = size_t(4) << 20; // 4 MiB
+
+    /// The size of the first buffer, which keeps small outputs small.
+    static constexpr size_t INITIAL_BUFFER_SIZE = size_t(64) << 10; // 64 KiB
+
+    /// Outputs of at least this size get dropped from the page cache.
+    static constexpr size_t DONTNEED_THRESHOLD = size_t(64) << 20; // 64 MiB
+
+private:
+    struct FreeDeleter {
+        inline void operator()(uint8_t* p) const { std::free(p); }
+    };
+    using buffer_t = std::unique_ptr<uint8_t, FreeDeleter>;
+
+    std::string m_path;
+    int m_fd;
+    bool m_direct;
+
+    size_t m_buffer_size;
+    buffer_t m_buffers[2];
+    size_t m_capacity[2] = { 0, 0 };
+    size_t m_current = 0;
+
+    size_t m_file_offset = 0; // size of the file before writing
+    size_t m_submitted = 0;   // bytes handed to the writer
+
+    // writer thread state, guarded by m_mutex
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    const uint8_t* m_pending = nullptr;
+    size_t m_pending_size = 0;
+    size_t m_written = 0; // only modified by the writer
+    bool m_shutdown = false;
+    bool m_failed = false;
+
+    inline static buffer_t allocate(size_t size) {
+        void* p = nullptr;
+        if(posix_memalign(&p, ALIGNMENT, size) != 0) {
+            throw std::bad_alloc();
+        }
+        return buffer_t((uint8_t*) p);
+    }
+
+    inline uint8_t* current() {
+        return m_buffers[m_current].get();
+    }
+
+    inline void reset_put_area() {
+        setp((char*) current(), (char*) current() + m_capacity[m_current]);
+    }
+
+    inline void disable_direct() {
+#ifdef O_DIRECT
+        if(m_direct) {
+            fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) & ~O_DIRECT);
+            m_direct = false;
+        }
+#endif
+    }
+
+    // writes synchronously, returns false on failure
+    inline bool write_fully(const uint8_t* data, size_t size) {
+        while(size > 0) {
+            const ssize_t ret = ::write(m_fd, data, size);
+            if(ret < 0) {
+                if(errno == EINTR) continue;
+                if(errno == EINVAL && m_direct) {
+                    // the file system does not support direct I/O after all
+                    disable_direct();
+                    continue;
+                }
+                return false;
+            }
+            data += ret;
+            size -= ret;
+        }
+        return true;
+    }
+
+    inline void drop_from_cache(size_t end) {
+#if defined(__linux__) && defined(POSIX_FADV_DONTNEED)
+        if(!m_direct && end >= DONTNEED_THRESHOLD) {
+            // the previous buffer was written by now, so its pages are
+            // waited for and dropped, while the current one is in flight
+            const size_t begin = end - std::min(end, 2 * m_buffer_size);
+            const size_t len = std::min(end - begin, m_buffer_size);
+            sync_file_range(m_fd, m_file_offset + begin, len,
+                SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE |
+                SYNC_FILE_RANGE_WAIT_AFTER);
+            posix_fadvise(m_fd, m_file_offset + begin, len, POSIX_FADV_DONTNEED);
+        }
+#endif
+    }
+
+    inline void writer_loop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true) {
+            m_cv.wait(lock, [&]{ return m_pending || m_shutdown; });
+            if(!m_pending) return;
+
+            const uint8_t* data = m_pending;
+            const size_t size = m_pending_size;
+
+            lock.unlock();
+            const bool ok = write_fully(data, size);
+            drop_from_cache(m_written + size);
+            lock.lock();
+
+            m_failed = m_failed || !ok;
+            m_written += size;
+            m_pending = nullptr;
+            m_cv.notify_all();
+        }
+    }
+
+    // waits until the writer is idle, returns false if a write failed
+    inline bool wait_idle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&]{ return m_pending == nullptr; });
+        return !m_failed;
+    }
+
+    // hands the current buffer to the writer and continues in the other one
+    inline bool submit() {
+        const size_t size = pptr() - pbase();
+        if(size == 0) return wait_idle();
+
+        if(!wait_idle()) return false;
+
+        if(!m_writer.joinable()) {
+            m_writer = std::thread([this]{ writer_loop(); });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending = current();
+            m_pending_size = size;
+        }
+        m_cv.notify_all();
+        m_submitted += size;
+
+        // the other buffer is not in use by the writer anymore
+        m_current ^= 1;
+        if(m_capacity[m_current] < m_buffer_size) {
+            m_buffers[m_current] = allocate(m_buffer_size);
+            m_capacity[m_current] = m_buffer_size;
+        }
+        reset_put_area();
+        return true;
+    }
+
+public:
+    /// Opens the file for writing.
+    ///
+    /// \param path The file path.
+    /// \param overwrite Whether to truncate the file instead of appending.
+    /// \param direct Whether to bypass the page cache via `O_DIRECT`, if
+    ///               supported by the file system.
+    /// \param buffer_size The size of each of the two buffers, rounded up
+    ///                    to the alignment.
+    inline AsyncFileStreamBuffer(const std::string& path,
+                                 bool overwrite,
+                                 bool direct = false,
+                                 size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : m_path(path), m_direct(false)
+    {
+        const int flags = O_WRONLY | O_CREAT | (overwrite ? O_TRUNC : O_APPEND);
+        m_fd = ::open(path.c_str(), flags, 0666);
+        if(m_fd < 0) {
+            throw tdc_output_file_not_found_error(m_path);
+        }
+
+        struct stat st;
+        if(fstat(m_fd, &st) == 0) m_file_offset = st.st_size;
+
+#ifdef O_DIRECT
+        // direct I/O needs aligned file offsets,
+        // and is not supported by every file system
+        if(direct && m_file_offset % ALIGNMENT == 0) {
+            m_direct = fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_DIRECT) == 0;
+        }
+#endif
+
+        m_buffer_size = std::max(size_t(ALIGNMENT),
+            (buffer_size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+        m_capacity[0] = std::min(size_t(INITIAL_BUFFER_SIZE), m_buffer_size);
+        m_buffers[0] = allocate(m_capacity[0]);
+        reset_put_area();
+    }
+
+    AsyncFileStreamBuffer(const AsyncFileStreamBuffer&) = delete;
+    AsyncFileStreamBuffer& operator=(const AsyncFileStreamBuffer&) = delete;
+
+    virtual ~AsyncFileStreamBuffer() {
+        sync();
+        if(m_writer.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_shutdown = true;
+            }
+            m_cv.notify_all();
+            m_writer.join();
+        }
+        ::close(m_fd);
+    }
+
+    /// Appends raw bytes to the output.
+    inline bool append(const uint8_t* data, size_t size) {
+        while(size > 0) {
+            if(pptr() == epptr() && !submit()) return false;
+
+            const size_t n = std::min(size, size_t(epptr() - pptr()));
+            std::memcpy(pptr(), data, n);
+            pbump(int(n));
+            data += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    /// Returns the amount of bytes written via this buffer so far.
+    inline size_t size() const {
+        return m_submitted + (pptr() - pbase());
+    }
+
+protected:
+    virtual int overflow(int ch) override {
+        if(!submit()) return EOF;
+        if(ch != EOF) {
+            *pptr() = char(ch);
+            pbump(1);
+        }
+        return ch == EOF ? 0 : ch;
+    }
+
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override {
+        return append((const uint8_t*) s, size_t(n)) ? n : 0;
+    }
+
+    /// Writes all buffered data to the file and waits for completion.
+    virtual int sync() override {
+        const size_t size = pptr() - pbase();
+        if(!wait_idle()) return -1;
+
+        if(size > 0) {
+            // a partial buffer breaks the alignment needed for direct I/O
+            if(size % ALIGNMENT != 0) disable_direct();
+
+            if(!write_fully(current(), size)) return -1;
+            m_submitted += size;
+            reset_put_area();
+        }
+        return 0;
+    }
+
+    virtual pos_type seekoff(off_type off,
+                             std::ios_base::seekdir dir,
+                             std::ios_base::openmode which) override {
+        // only reporting the position (tellp) is supported
+        if(off == 0 && dir == std::ios_base::cur && (which & std::ios_base::out)) {
+            return pos_type(off_type(m_file_offset + size()));
+        }
+        return pos_type(off_type(-1));
+    }
+};
+
+/// \endcond
+
+}}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <climits>
 #include <cstdint>
 #include <iostream>
@@ -16,9 +17,16 @@ namespace io {
 ///
 /// Bits are written into a buffer byte, which is written to the output when
 /// it is either filled or when a flush is explicitly requested.
+///
+/// Completed bytes are collected in a small block and appended to the
+/// output stream at once, rather than putting each byte into the stream.
 class BitOStream {
     OutputStream m_stream;
 
+    static constexpr size_t BLOCK_SIZE = 1024;
+    std::array<uint8_t, BLOCK_SIZE> m_block;
+    size_t m_block_size = 0;
+
     uint8_t m_next;
     int8_t m_cursor;
     static constexpr int8_t MSB = 7;
@@ -34,8 +42,20 @@ class BitOStream {
         m_cursor = MSB;
     }
 
+    inline void flush_block() {
+        if(m_block_size > 0) {
+            m_stream.append(m_block.data(), m_block_size);
+            m_block_size = 0;
+        }
+    }
+
+    inline void write_byte(uint8_t byte) {
+        if(m_block_size == BLOCK_SIZE) flush_block();
+        m_block[m_block_size++] = byte;
+    }
+
     inline void write_next() {
-        m_stream.put(char(m_next));
+        write_byte(m_next);
         reset();
     }
 
@@ -87,6 +107,7 @@ public:
             m_next = set_bits;
             write_next();
         }
+        flush_block();
     }
 
     /// \brief Asserts that the next write operation starts on a byte boundary
@@ -99,6 +120,7 @@ public:
     /// Note that the stream does not include bits that have not yet been
     /// flushed.
     inline std::ostream& stream() {
+        flush_block();
         return m_stream;
     }
 
@@ -164,7 +186,9 @@ public:
                 #endif
 
                 const size_t off  = sizeof(size_t) - n;
-                m_stream.write(((const char*)&v_bytes) + off, n);
+                for(size_t i = 0; i < n; i++) {
+                    write_byte(((const uint8_t*)&v_bytes)[off + i]);
+                }
 
                 v &= (1ULL << bits) - 1ULL; // mask remaining bits
             }
@@ -234,5 +258,96 @@ public:
     inline size_t bits_written() const { return m_bits_written; }
 };
 
+/// \brief Collects bits in a word before writing them to a \ref BitOStream.
+///
+/// Writing many short codes to a bit stream directly is dominated by the
+/// per-call cursor handling. The packer instead shifts the codes into a
+/// 64-bit word and only writes whole words to the stream. The bits are
+/// written in the same order as if they had been written to the stream
+/// directly, and the remainder is flushed when the packer is destroyed.
+class BitPacker {
+    BitOStream* m_out;
+    uint64_t m_word = 0;
+    size_t m_bits = 0; // always less than 64
+
+    struct BitSink {
+        BitPacker* m_ptr;
+
+        inline void write_bit(bool set) {
+            m_ptr->write_bit(set);
+        }
+
+        template<typename T>
+        inline void write_int(T value, size_t bits = sizeof(T) * CHAR_BIT) {
+            m_ptr->write_int(value, bits);
+        }
+    };
+
+public:
+    /// \brief Constructs a packer for the given stream.
+    ///
+    /// \param out The stream to write to. No other writes may happen to it
+    ///            while the packer holds bits.
+    inline BitPacker(BitOStream& out) : m_out(&out) {
+    }
+
+    BitPacker(const BitPacker&) = delete;
+    BitPacker& operator=(const BitPacker&) = delete;
+
+    inline ~BitPacker() {
+        flush();
+    }
+
+    /// \brief Writes a single bit.
+    /// \param set The bit value (0 or 1).
+    inline void write_bit(bool set) {
+        m_word = (m_word << 1) | uint64_t(set);
+        if(++m_bits == 64) {
+            m_out->write_int(m_word, 64);
+            m_word = 0;
+            m_bits = 0;
+        }
+    }
+
+    /// \brief Writes the low bits of an integer in MSB first order.
+    ///
+    /// \param value The integer to write.
+    /// \param bits The amount of low bits of the value to write.
+    template<class T>
+    inline void write_int(const T value, size_t bits = sizeof(T) * CHAR_BIT) {
+        DCHECK_LE(bits, 64ULL);
+        const uint64_t v = (bits < 64ULL) ?
+            (uint64_t(value) & ((1ULL << bits) - 1ULL)) : uint64_t(value);
+
+        if(m_bits + bits < 64ULL) {
+            m_word = (m_word << bits) | v;
+            m_bits += bits;
+        } else {
+            // complete the word with the high bits of the value
+            const size_t hi = 64ULL - m_bits;
+            const size_t lo = bits - hi;
+            m_word = ((hi < 64ULL) ? (m_word << hi) : 0ULL) | (v >> lo);
+            m_out->write_int(m_word, 64);
+
+            m_word = v & ((1ULL << lo) - 1ULL);
+            m_bits = lo;
+        }
+    }
+
+    /// \brief Returns a sink for the integer codes in `int_coder.hpp`.
+    inline BitSink bit_sink() {
+        return BitSink { this };
+    }
+
+    /// \brief Writes the collected bits to the stream.
+    inline void flush() {
+        if(m_bits > 0) {
+            m_out->write_int(m_word, m_bits);
+            m_word = 0;
+            m_bits = 0;
+        }
+    }
+};
+
 }}
 
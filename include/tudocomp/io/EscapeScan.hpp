@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <tudocomp/io/EscapeMap.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/// \cond INTERNAL
+namespace tdc {namespace io {
+    /// Counts and escapes the bytes of an escape map in memory blocks.
+    ///
+    /// A block of 32 (AVX2) or 16 (SSE2) bytes is compared against every
+    /// byte that needs escaping, and the resulting bit mask decides whether
+    /// the block needs to be looked at byte by byte at all. Escape sets are
+    /// tiny in practice (a sentinel escapes the 0 byte and the escape byte),
+    /// so for larger sets the plain table lookup is used instead.
+    class EscapeScan {
+#if defined(__AVX2__)
+        using block_t = __m256i;
+#elif defined(__SSE2__)
+        using block_t = __m128i;
+#endif
+
+        static constexpr size_t MAX_SIMD_BYTES = 8;
+
+        FastEscapeMap m_map;
+        std::vector<uint8_t> m_bytes;
+        bool m_simd;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+        static constexpr size_t BLOCK = sizeof(block_t);
+
+        block_t m_patterns[MAX_SIMD_BYTES];
+
+        // bit i is set iff p[i] needs to be escaped
+        inline uint32_t block_mask(const uint8_t* p) const {
+#if defined(__AVX2__)
+            const block_t x = _mm256_loadu_si256((const block_t*)p);
+            block_t eq = _mm256_cmpeq_epi8(x, m_patterns[0]);
+            for(size_t i = 1; i < m_bytes.size(); i++) {
+                eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(x, m_patterns[i]));
+            }
+            return uint32_t(_mm256_movemask_epi8(eq));
+#else
+            const block_t x = _mm_loadu_si128((const block_t*)p);
+            block_t eq = _mm_cmpeq_epi8(x, m_patterns[0]);
+            for(size_t i = 1; i < m_bytes.size(); i++) {
+                eq = _mm_or_si128(eq, _mm_cmpeq_epi8(x, m_patterns[i]));
+            }
+            return uint32_t(_mm_movemask_epi8(eq));
+#endif
+        }
+#else
+        static constexpr size_t BLOCK = 1;
+#endif
+
+    public:
+        inline EscapeScan(const EscapeMap& em):
+            m_map(em), m_bytes(em.escape_bytes())
+        {
+#if defined(__AVX2__) || defined(__SSE2__)
+            m_simd = !m_bytes.empty() && m_bytes.size() <= MAX_SIMD_BYTES;
+            for(size_t i = 0; m_simd && i < m_bytes.size(); i++) {
+#if defined(__AVX2__)
+                m_patterns[i] = _mm256_set1_epi8(char(m_bytes[i]));
+#else
+                m_patterns[i] = _mm_set1_epi8(char(m_bytes[i]));
+#endif
+            }
+#else
+            m_simd = false;
+#endif
+        }
+
+        /// Returns the amount of bytes in `[begin, end)` that need escaping.
+        inline size_t count(const uint8_t* begin, const uint8_t* end) const {
+            if(m_bytes.empty()) return 0;
+
+            size_t extra = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+            if(m_simd) {
+                for(; size_t(end - begin) >= BLOCK; begin += BLOCK) {
+                    extra += __builtin_popcount(block_mask(begin));
+                }
+            }
+#endif
+            for(; begin != end; ++begin) {
+                extra += m_map.lookup_flag(*begin);
+            }
+            return extra;
+        }
+
+        /// Escapes `[begin, end)` into the memory ending at `write_end`,
+        /// which needs to provide room for `count(begin, end)` extra bytes.
+        ///
+        /// The memory is processed from back to front, so the target may
+        /// overlap the source as long as `write_end >= end`.
+        inline void escape(const uint8_t* begin,
+                           const uint8_t* end,
+                           uint8_t* write_end) const {
+            if(m_bytes.empty()) {
+                // nothing to escape, just move the data
+                const size_t n = end - begin;
+                if(write_end - n != begin) std::memmove(write_end - n, begin, n);
+                return;
+            }
+
+            const uint8_t escape_byte = m_map.escape_byte();
+            while(begin != end) {
+#if defined(__AVX2__) || defined(__SSE2__)
+                // move blocks that need no escaping at once; the block is
+                // loaded entirely before it is stored
+                if(m_simd && size_t(end - begin) >= BLOCK &&
+                   block_mask(end - BLOCK) == 0) {
+                    end -= BLOCK;
+                    write_end -= BLOCK;
+                    block_t x;
+                    std::memcpy(&x, end, BLOCK);
+                    std::memcpy(write_end, &x, BLOCK);
+                    continue;
+                }
+                const uint8_t* block_begin = (size_t(end - begin) >= BLOCK)
+                    ? end - BLOCK : begin;
+#else
+                const uint8_t* block_begin = end - 1;
+#endif
+                while(end != block_begin) {
+                    const uint8_t current_byte = *--end;
+                    *--write_end = m_map.lookup_byte(current_byte);
+                    if(m_map.lookup_flag_bool(current_byte)) {
+                        *--write_end = escape_byte;
+                    }
+                }
+            }
+        }
+    };
+}}
+/// \endcond
@@ -58,15 +58,18 @@ namespace io {
             std::string m_path;
             // TODO:
             mutable bool m_overwrite;
+            bool m_direct;
 
             File(const File& other, const InputRestrictions& r):
                 Variant(r),
                 m_path(other.m_path),
-                m_overwrite(other.m_overwrite) {}
+                m_overwrite(other.m_overwrite),
+                m_direct(other.m_direct) {}
         public:
-            File(const std::string& path, bool overwrite):
+            File(const std::string& path, bool overwrite, bool direct):
                 m_path(path),
-                m_overwrite(overwrite) {}
+                m_overwrite(overwrite),
+                m_direct(direct) {}
 
             inline std::unique_ptr<Variant> unrestrict(const InputRestrictions& rest) const override {
                 return std::make_unique<File>(
@@ -105,11 +108,17 @@ namespace io {
         /// \brief Constructs an output that appends to the file at the given
         /// path.
         ///
+        /// The file is written asynchronously in large blocks, overlapping
+        /// disk writes with the computation.
+        ///
         /// \param path The path to the output file.
         /// \param overwrite If \c true, the file will be overwritten in case
         /// it already exists, otherwise the output will be appended to it.
-        inline Output(const Path& path, bool overwrite=false):
-            m_data(std::make_unique<File>(std::move(path.path), overwrite)) {}
+        /// \param direct If \c true, the file is written bypassing the page
+        /// cache (\c O_DIRECT) if supported, which is useful for large
+        /// outputs that are not read again soon.
+        inline Output(const Path& path, bool overwrite=false, bool direct=false):
+            m_data(std::make_unique<File>(std::move(path.path), overwrite, direct)) {}
 
         /// \brief Constructs an output that appends to the byte vector.
         ///
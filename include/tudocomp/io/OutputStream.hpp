@@ -8,8 +8,9 @@
 #include <utility>
 #include <vector>
 
+#include <tudocomp/io/AsyncFileStreamBuffer.hpp>
 #include <tudocomp/io/BackInsertStream.hpp>
-#include<tudocomp/io/RestrictedIOStream.hpp>
+#include <tudocomp/io/RestrictedIOStream.hpp>
 
 namespace tdc {
 namespace io {
@@ -23,6 +24,11 @@ namespace io {
             virtual std::streampos tellp() {
                 return stream().tellp();
             }
+
+            virtual bool append(const uint8_t* data, size_t size) {
+                auto n = stream().rdbuf()->sputn((const char*) data, size);
+                return size_t(n) == size;
+            }
         };
 
         class Memory: public Variant {
@@ -65,33 +71,34 @@ namespace io {
         };
         class File: public Variant {
             std::string m_path;
-            std::unique_ptr<std::ofstream> m_stream;
+            std::unique_ptr<AsyncFileStreamBuffer> m_buffer;
+            std::unique_ptr<std::ostream> m_stream;
 
         public:
             friend class OutputStreamInternal;
 
-            inline File(std::string&& path, bool overwrite = false) {
+            inline File(std::string&& path,
+                        bool overwrite = false,
+                        bool direct = false) {
                 m_path = path;
-                if (overwrite) {
-                    m_stream = std::make_unique<std::ofstream>(m_path,
-                        std::ios::out | std::ios::binary);
-                } else {
-                    m_stream = std::make_unique<std::ofstream>(m_path,
-                        std::ios::out | std::ios::binary | std::ios::app);
-                }
-                if (!*m_stream) {
-                    throw tdc_output_file_not_found_error(m_path);
-                }
+                m_buffer = std::make_unique<AsyncFileStreamBuffer>(
+                    m_path, overwrite, direct);
+                m_stream = std::make_unique<std::ostream>(&*m_buffer);
             }
 
             inline File(File&& other):
                 m_path(std::move(other.m_path)),
+                m_buffer(std::move(other.m_buffer)),
                 m_stream(std::move(other.m_stream)) {}
 
             inline std::ostream& stream() override {
                 return *m_stream;
             }
 
+            inline bool append(const uint8_t* data, size_t size) override {
+                return m_buffer->append(data, size);
+            }
+
             inline File(const File& other) = delete;
             inline File() = delete;
         };
@@ -154,6 +161,18 @@ namespace io {
         inline std::streampos tellp() {
             return m_variant->tellp();
         }
+
+        inline bool append(const uint8_t* data, size_t size) {
+            if (!m_variant) {
+                return false; // moved from
+            } else if (m_restricted_ostream) {
+                // restricted output needs to be escaped
+                auto n = m_restricted_ostream->sputn((const char*) data, size);
+                return size_t(n) == size;
+            } else {
+                return m_variant->append(data, size);
+            }
+        }
     };
     /// \endcond
 
@@ -180,6 +199,20 @@ namespace io {
         inline std::streampos tellp() {
             return OutputStreamInternal::tellp();
         }
+
+        /// \brief Appends a block of raw bytes to the output.
+        ///
+        /// Unlike \c write, this does not go through the formatting layer
+        /// of \c std::ostream and copies the block into the output buffer
+        /// at once where possible.
+        ///
+        /// \param data The bytes to write.
+        /// \param size The amount of bytes to write.
+        inline void append(const uint8_t* data, size_t size) {
+            if (!OutputStreamInternal::append(data, size)) {
+                setstate(std::ios_base::badbit);
+            }
+        }
     };
 
     inline OutputStream Output::Memory::as_stream() const {
@@ -203,6 +236,7 @@ namespace io {
                 OutputStream::File {
                     std::string(m_path),
                     overwrite,
+                    m_direct,
                 },
                 restrictions()
             }
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -13,6 +14,7 @@
 #include <tudocomp/io/InputRestrictions.hpp>
 #include <tudocomp/io/IOUtil.hpp>
 #include <tudocomp/io/EscapeMap.hpp>
+#include <tudocomp/io/EscapeScan.hpp>
 
 /// \cond INTERNAL
 namespace tdc {namespace io {
@@ -39,63 +41,32 @@ namespace tdc {namespace io {
         // [   [offset|from_______to]     ]
         size_t m_mmap_page_offset = 0;
 
-        template<typename I, typename J>
-        inline void escape_with_iters(I read_begin, I read_end, J write_end, bool do_copy = false) {
-            if (!m_restrictions.has_no_escape_restrictions()) {
-                FastEscapeMap fast_escape_map;
-                uint8_t escape_byte;
-
-                {
-                    EscapeMap em(m_restrictions);
-                    fast_escape_map = FastEscapeMap(em);
-                    escape_byte = fast_escape_map.escape_byte();
-                }
-
-                while(read_begin != read_end) {
-                    --read_end;
-                    --write_end;
-
-                    uint8_t current_byte = *read_end;
-
-                    *write_end = fast_escape_map.lookup_byte(current_byte);
+        // Escapes [read_begin, read_end) into the memory ending at write_end,
+        // from back to front so it can be done in place.
+        inline void escape_with_iters(const uint8_t* read_begin,
+                                      const uint8_t* read_end,
+                                      uint8_t* write_end,
+                                      bool do_copy = false) {
+            if (write_end == read_end) {
+                // in place and nothing to escape
+                return;
+            }
 
-                    if (fast_escape_map.lookup_flag_bool(current_byte)) {
-                        --write_end;
-                        *write_end = escape_byte;
-                    }
-                }
+            if (!m_restrictions.has_no_escape_restrictions()) {
+                EscapeScan scan { EscapeMap(m_restrictions) };
+                scan.escape(read_begin, read_end, write_end);
             } else if (do_copy) {
-                while(read_begin != read_end) {
-                    --read_end;
-                    --write_end;
-                    *write_end = *read_end;
-                }
+                const size_t n = read_end - read_begin;
+                std::memmove(write_end - n, read_begin, n);
             }
         }
 
-        // NB: The len argument would be redundant, but exists because
-        // the istream iterator does not allow efficient slicing of the input file
-        // TODO: Define custom sliceable ifstream iterator
-        // TODO: ^ Needed in Input as well
-        template<typename T>
-        inline size_t extra_size_needed_due_restrictions(T begin, T end, size_t len) {
+        inline size_t extra_size_needed_due_restrictions(View s) {
             size_t extra = 0;
 
             if (!m_restrictions.has_no_escape_restrictions()) {
-                size_t i = 0;
-
-                FastEscapeMap fast_escape_map{EscapeMap(m_restrictions)};
-
-                while((begin != end) && (i < len)) {
-                    uint8_t current_byte = *begin;
-
-                    extra += fast_escape_map.lookup_flag(current_byte);
-
-                    ++begin;
-                    ++i;
-                }
-
-                DCHECK_EQ(i, len);
+                EscapeScan scan { EscapeMap(m_restrictions) };
+                extra += scan.count(s.begin(), s.end());
             }
 
             if (m_restrictions.null_terminate()) {
@@ -114,8 +85,7 @@ namespace tdc {namespace io {
                     s = m_source.view().slice(m_from, m_to);
                 }
 
-                size_t extra_size = extra_size_needed_due_restrictions(
-                    s.cbegin(), s.cend(), s.size());
+                size_t extra_size = extra_size_needed_due_restrictions(s);
 
                 if (extra_size != 0) {
                     size_t size = s.size() + extra_size;
@@ -124,7 +94,14 @@ namespace tdc {namespace io {
                     {
                         GenericView<uint8_t> target = m_map.view();
                         size_t noff = m_restrictions.null_terminate()? 1 : 0;
-                        escape_with_iters(s.cbegin(), s.cend(), target.end() - noff, true);
+                        if (extra_size == noff) {
+                            // Only the sentinel is appended. The view is
+                            // owned by the caller and may end right at the
+                            // last byte, so it can not be extended in place.
+                            std::memcpy(target.begin(), s.data(), s.size());
+                        } else {
+                            escape_with_iters(s.begin(), s.end(), target.end() - noff, true);
+                        }
                         // For null termination, a trailing byte is implicit 0
                     }
 
@@ -143,25 +120,13 @@ namespace tdc {namespace io {
                 }
 
                 auto path = m_source.file();
-                auto c_path = path.c_str();
-
-                size_t extra_size = 0;
-                {
-                    auto ifs = create_tdc_ifstream(c_path, m_from);
-
-                    std::istreambuf_iterator<char> begin (ifs);
-                    std::istreambuf_iterator<char> end;
-
-                    extra_size = extra_size_needed_due_restrictions(
-                        begin, end, unrestricted_size);
-                }
 
                 size_t aligned_offset = MMap::next_valid_offset(m_from);
                 m_mmap_page_offset = m_from - aligned_offset;
 
                 DCHECK_EQ(aligned_offset + m_mmap_page_offset, m_from);
 
-                size_t map_size = unrestricted_size + extra_size + m_mmap_page_offset;
+                size_t map_size = unrestricted_size + m_mmap_page_offset;
 
                 if (m_restrictions.has_no_restrictions()) {
                     m_map = MMap(path, MMap::Mode::Read, map_size, aligned_offset);
@@ -169,10 +134,27 @@ namespace tdc {namespace io {
                     const auto& m = m_map;
                     m_restricted_data = m.view().slice(m_mmap_page_offset);
                 } else {
-                    m_map = MMap(path, MMap::Mode::ReadWrite, map_size, aligned_offset);
-
                     size_t noff = m_restrictions.null_terminate()? 1 : 0;
 
+                    // Load the file first and count the escapeable bytes in
+                    // memory, then grow the mapping by the extra size.
+                    // MMap never maps files directly but reads them into
+                    // anonymous memory, so requesting one more byte than
+                    // the file for the sentinel costs no extra copy; the
+                    // sentinel is written in place below.
+                    m_map = MMap(path, MMap::Mode::ReadWrite, map_size + noff, aligned_offset);
+
+                    size_t extra_size;
+                    {
+                        const auto& m = m_map;
+                        extra_size = extra_size_needed_due_restrictions(
+                            m.view().slice(m_mmap_page_offset, map_size));
+                    }
+
+                    if (extra_size > noff) {
+                        m_map.remap(map_size + extra_size);
+                    }
+
                     uint8_t* begin_file_data = m_map.view().begin() + m_mmap_page_offset;
                     uint8_t* end_file_data   = begin_file_data      + unrestricted_size;
                     uint8_t* end_data        = end_file_data        + extra_size - noff;
@@ -191,16 +173,8 @@ namespace tdc {namespace io {
                 // for small inputs
                 size_t capacity = pagesize();
                 size_t size = 0;
-                size_t extra_size = 0;
-                FastEscapeMap fast_escape_map;
-                if (!m_restrictions.has_no_escape_restrictions()) {
-                    fast_escape_map = FastEscapeMap {
-                        EscapeMap(m_restrictions)
-                    };
-                }
 
                 size_t noff = m_restrictions.null_terminate()? 1 : 0;
-                extra_size += noff;
 
                 // Initial allocation
 
@@ -209,38 +183,34 @@ namespace tdc {namespace io {
                 // Fill and grow
                 {
                     std::istream& is = *(m_source.stream());
-                    bool done = false;
 
-                    while(!done) {
+                    while(true) {
                         // fill until capacity
-                        uint8_t* ptr = m_map.view().begin() + size;
-                        while(size < capacity) {
-                            char c;
-                            if(!is.get(c)) {
-                                done = true;
-                                break;
-                            } else {
-                                *ptr = uint8_t(c);
-                                ++ptr;
-                                ++size;
-                                extra_size += fast_escape_map.lookup_flag(uint8_t(c));
-                            }
-                        }
-                        if (done) break;
+                        char* ptr = (char*) m_map.view().begin() + size;
+                        is.read(ptr, capacity - size);
+                        size += is.gcount();
+                        if (size < capacity) break;
 
                         // realloc to greater size;
                         capacity *= 2;
                         m_map.remap(capacity);
                     }
+                }
 
-                    // Throw away overallocation
-                    // For null termination,
-                    // a trailing unwritten byte is automatically 0
-                    m_map.remap(size + extra_size);
-
-                    m_restricted_data = m_map.view();
+                size_t extra_size;
+                {
+                    const auto& m = m_map;
+                    extra_size = extra_size_needed_due_restrictions(
+                        m.view().slice(0, size));
                 }
 
+                // Throw away overallocation
+                // For null termination,
+                // a trailing unwritten byte is automatically 0
+                m_map.remap(size + extra_size);
+
+                m_restricted_data = m_map.view();
+
                 // Escape
                 {
                     uint8_t* begin_stream_data = m_map.view().begin();
@@ -316,9 +286,7 @@ namespace tdc {namespace io {
             {
                 View s = other.view();
                 other.m_restrictions = restrictions;
-                extra_size = other.extra_size_needed_due_restrictions(
-                    s.cbegin(), s.cend(), s.size()
-                );
+                extra_size = other.extra_size_needed_due_restrictions(s);
                 old_size = s.size();
             }
 
@@ -303,7 +303,7 @@ public:
             m_meta->m_decl->add_param(Decl::Param(
                 m_name, m_desc,
                 Decl::Param::Kind::unbound,
-                false, // no list
+                true, // list
                 type,
                 defaults
             ));
@@ -383,6 +383,10 @@ public:
         return (m_tags.find(tag_name) != m_tags.end());
     }
 
+    inline const std::unordered_set<std::string>& tags() const {
+        return m_tags;
+    }
+
     template<typename Algo>
     inline void inherit_tag(const std::string& tag_name) {
         if(Algo::meta().has_tag(tag_name)) {
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <tudocomp/meta/Config.hpp>
@@ -31,10 +32,16 @@ public:
 
 private:
     using ctor_t = std::function<std::unique_ptr<T>(Config&&)>;
+    using tags_t = std::unordered_set<std::string>;
+
+    struct Registered {
+        ctor_t ctor;
+        tags_t tags; // the tags of the registered instance
+    };
 
     TypeDesc m_root_type;
     DeclLib m_lib;
-    std::unordered_map<std::string, ctor_t> m_reg;
+    std::unordered_map<std::string, Registered> m_reg;
 
     std::vector<register_callback_t> m_callback;
 
@@ -61,8 +68,11 @@ public:
         auto it = m_reg.find(sig);
         if(it == m_reg.end()) {
             add_to_lib(m_lib, meta);
-            m_reg.emplace(sig, [](Config&& cfg) {
-                return std::make_unique<Algo>(std::move(cfg));
+            m_reg.emplace(sig, Registered {
+                [](Config&& cfg) {
+                    return std::make_unique<Algo>(std::move(cfg));
+                },
+                meta.tags()
             });
         } else {
             throw RegistryError(std::string("already registered: ") + sig);
@@ -135,13 +145,13 @@ public:
         friend class RegistryOf;
 
         std::shared_ptr<const Decl> m_decl;
-        const ctor_t* m_ctor;
+        const Registered* m_reg;
         Config m_cfg;
 
         inline Entry(
             std::shared_ptr<const Decl> decl,
-            const ctor_t& ctor,
-            Config&& cfg) : m_decl(decl), m_ctor(&ctor), m_cfg(cfg) {
+            const Registered& reg,
+            Config&& cfg) : m_decl(decl), m_reg(&reg), m_cfg(cfg) {
         }
 
     public:
@@ -149,8 +159,13 @@ public:
             return m_decl;
         }
 
+        /// Tests whether the registered instance has the given tag.
+        inline bool has_tag(const std::string& tag_name) const {
+            return (m_reg->tags.find(tag_name) != m_reg->tags.end());
+        }
+
         inline Selection select() const {
-            return Selection(m_decl, (*m_ctor)(Config(m_cfg)));
+            return Selection(m_decl, m_reg->ctor(Config(m_cfg)));
         }
     };
 
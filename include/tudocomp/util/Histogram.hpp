@@ -0,0 +1,250 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/Literal.hpp>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace tdc {
+
+/// \cond INTERNAL
+namespace histogram {
+
+using lanes_t = std::array<std::array<size_t, 256>, 4>;
+
+/// Counts the bytes into four separate counter lanes.
+///
+/// Consecutive bytes are counted in different lanes, so runs of the same
+/// byte do not have to wait for the previous increment of the same counter.
+inline void count_lanes(const uint8_t* data, size_t n, lanes_t& lanes) {
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        ++lanes[0][ w        & 0xFFU];
+        ++lanes[1][(w >>  8) & 0xFFU];
+        ++lanes[2][(w >> 16) & 0xFFU];
+        ++lanes[3][(w >> 24) & 0xFFU];
+        ++lanes[0][(w >> 32) & 0xFFU];
+        ++lanes[1][(w >> 40) & 0xFFU];
+        ++lanes[2][(w >> 48) & 0xFFU];
+        ++lanes[3][(w >> 56)        ];
+    }
+    for(; i < n; ++i) {
+        ++lanes[i & 3U][data[i]];
+    }
+}
+
+template<typename count_t>
+inline void add_lanes(const lanes_t& lanes, count_t* counts) {
+    for(size_t c = 0; c < 256; ++c) {
+        const size_t sum = lanes[0][c] + lanes[1][c] + lanes[2][c] + lanes[3][c];
+        counts[c] = count_t(size_t(counts[c]) + sum);
+    }
+}
+
+/// Tests whether a literal iterator is backed by a \ref View.
+template<typename literals_t, typename = void>
+struct has_view : std::false_type {};
+
+template<typename literals_t>
+struct has_view<literals_t,
+    decltype(void(std::declval<literals_t&>().take_view()))> : std::true_type {};
+
+}
+/// \endcond
+
+/// \brief The minimum number of bytes for which \ref count_bytes uses
+///        multiple threads.
+constexpr size_t HISTOGRAM_PARALLEL_MIN = 1ULL << 20;
+
+/// \brief Counts the occurrences of each byte value.
+///
+/// The counts are added to `counts[0..255]`. Large inputs are split into
+/// one chunk per thread if OpenMP is enabled.
+///
+/// \param data The bytes to count.
+/// \param n The number of bytes.
+/// \param counts The 256 counters to add to.
+template<typename count_t>
+inline void count_bytes(const uint8_t* data, size_t n, count_t* counts) {
+#ifdef ENABLE_OPENMP
+    const size_t max_threads = omp_get_max_threads();
+    if(n >= HISTOGRAM_PARALLEL_MIN && max_threads > 1) {
+        std::vector<histogram::lanes_t> partial(max_threads);
+
+        #pragma omp parallel
+        {
+            const size_t t = omp_get_thread_num();
+            const size_t num_threads = omp_get_num_threads();
+            const size_t begin = n * t / num_threads;
+            const size_t end = n * (t + 1) / num_threads;
+
+            auto& lanes = partial[t];
+            for(auto& lane : lanes) lane.fill(0);
+            histogram::count_lanes(data + begin, end - begin, lanes);
+        }
+
+        for(auto& lanes : partial) histogram::add_lanes(lanes, counts);
+        return;
+    }
+#endif
+
+    histogram::lanes_t lanes;
+    for(auto& lane : lanes) lane.fill(0);
+    histogram::count_lanes(data, n, lanes);
+    histogram::add_lanes(lanes, counts);
+}
+
+/// \cond INTERNAL
+namespace histogram {
+
+template<typename literals_t, typename count_t>
+inline size_t count_literals_impl(literals_t& literals, count_t* counts, std::true_type) {
+    const View view = literals.take_view();
+    ::tdc::count_bytes(view.data(), view.size(), counts);
+    return view.size();
+}
+
+template<typename literals_t, typename count_t>
+inline size_t count_literals_impl(literals_t& literals, count_t* counts, std::false_type) {
+    histogram::lanes_t lanes;
+    for(auto& lane : lanes) lane.fill(0);
+
+    size_t n = 0;
+    while(literals.has_next()) {
+        ++lanes[n & 3U][literals.next().c];
+        ++n;
+    }
+
+    histogram::add_lanes(lanes, counts);
+    return n;
+}
+
+}
+/// \endcond
+
+/// \brief Counts the occurrences of each literal in a literal iterator.
+///
+/// The counts are added to `counts[0..ULITERAL_MAX]`. The iterator is
+/// exhausted afterwards. Iterators backed by a \ref View are counted using
+/// \ref count_bytes.
+///
+/// \param literals The literal iterator.
+/// \param counts The counters to add to.
+/// \return The number of counted literals.
+template<typename literals_t, typename count_t>
+inline size_t count_literals(literals_t& literals, count_t* counts) {
+    static_assert(ULITERAL_MAX == 255, "literals are expected to be bytes");
+    return histogram::count_literals_impl(
+        literals, counts, histogram::has_view<literals_t>());
+}
+
+/// \brief Counts the occurrences of integer keys of a bounded bit width.
+///
+/// Keys of up to \ref FLAT_BITS bits are counted in a flat array, wider
+/// keys in an open addressing hash table with linear probing.
+class IntHistogram {
+public:
+    /// The maximum key width for which a flat array is used.
+    static constexpr size_t FLAT_BITS = 16;
+
+private:
+    struct Entry {
+        uint64_t key;
+        size_t count; // zero for empty slots
+    };
+
+    bool m_flat;
+    std::vector<size_t> m_counts;
+
+    std::vector<Entry> m_table;
+    size_t m_table_bits;
+    size_t m_size;
+
+    inline size_t slot(uint64_t key) const {
+        return (key * 0x9E3779B97F4A7C15ULL) >> (64 - m_table_bits);
+    }
+
+    inline void grow() {
+        std::vector<Entry> table(size_t(1) << (m_table_bits + 1), Entry { 0, 0 });
+        std::swap(table, m_table);
+        ++m_table_bits;
+
+        const size_t mask = m_table.size() - 1;
+        for(auto& e : table) {
+            if(e.count == 0) continue;
+            size_t i = slot(e.key);
+            while(m_table[i].count != 0) i = (i + 1) & mask;
+            m_table[i] = e;
+        }
+    }
+
+public:
+    /// \brief Constructs an empty histogram.
+    /// \param key_bits The maximum bit width of the keys.
+    inline IntHistogram(size_t key_bits)
+        : m_flat(key_bits <= FLAT_BITS), m_table_bits(10), m_size(0) {
+
+        if(m_flat) {
+            m_counts.resize(size_t(1) << key_bits, 0);
+        } else {
+            m_table.resize(size_t(1) << m_table_bits, Entry { 0, 0 });
+        }
+    }
+
+    /// \brief Increases the count of a key by one.
+    inline void increase(uint64_t key) {
+        if(m_flat) {
+            DCHECK_LT(key, m_counts.size());
+            m_size += (m_counts[key]++ == 0);
+            return;
+        }
+
+        const size_t mask = m_table.size() - 1;
+        size_t i = slot(key);
+        while(m_table[i].count != 0) {
+            if(m_table[i].key == key) {
+                ++m_table[i].count;
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+
+        m_table[i] = Entry { key, 1 };
+        if(2 * (++m_size) > m_table.size()) grow();
+    }
+
+    /// \brief Returns the number of distinct keys.
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// \brief Calls `f(key, count)` for each distinct key, in no particular
+    ///        order.
+    template<typename f_t>
+    inline void for_each(f_t f) const {
+        if(m_flat) {
+            for(size_t key = 0; key < m_counts.size(); ++key) {
+                if(m_counts[key]) f(uint64_t(key), m_counts[key]);
+            }
+        } else {
+            for(auto& e : m_table) {
+                if(e.count) f(e.key, e.count);
+            }
+        }
+    }
+};
+
+}
@@ -8,6 +8,7 @@
 #include <type_traits>
 
 #include <tudocomp/util.hpp>
+#include <tudocomp/util/Trace.hpp>
 
 #ifdef ENABLE_OPENMP
 #include <omp.h>
@@ -65,6 +66,9 @@ inline std::pair<std::vector<T>, bool> intsort_impl(const Iter begin, const Iter
         const size_t chunk_size = idiv_ceil(n, no_threads);
         const auto chunk = std::make_pair(chunk_size * tid, std::min(chunk_size * (tid + 1), n));
 
+        Trace::Scope trace("intsort");
+        trace.log("size", chunk.second - chunk.first);
+
         // thread-local counters and iterators
         IndexArray queue_pointer;
 
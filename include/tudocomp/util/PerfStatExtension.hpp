@@ -0,0 +1,140 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <tudocomp_stat/StatPhaseExtension.hpp>
+
+namespace tdc {
+
+/// Statistics extension that records hardware performance counters
+/// (cycles, instructions, LLC misses, branch misses and dTLB misses)
+/// for every \ref StatPhase.
+///
+/// The counters are opened once via `perf_event_open` and keep running
+/// for the calling thread; a phase only samples them when it begins and
+/// when it is written, so nothing is measured unless the extension has
+/// been registered. Counters that are not supported by the hardware or
+/// not permitted by the kernel (see `/proc/sys/kernel/perf_event_paranoid`)
+/// are omitted from the output. Work done by other threads, e.g. inside
+/// OpenMP regions, is not counted.
+class PerfStatExtension : public StatPhaseExtension {
+private:
+    struct Event {
+        const char* name;
+        uint32_t type;
+        uint64_t config;
+    };
+
+    static constexpr size_t NUM_EVENTS = 5;
+
+    static inline const std::array<Event, NUM_EVENTS>& events() {
+        static const std::array<Event, NUM_EVENTS> s_events {{
+            { "perf_cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { "perf_instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { "perf_llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { "perf_branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { "perf_dtlb_misses", PERF_TYPE_HW_CACHE,
+                PERF_COUNT_HW_CACHE_DTLB |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        }};
+        return s_events;
+    }
+
+    /// The counter file descriptors, -1 for unavailable counters.
+    class Counters {
+        std::array<int, NUM_EVENTS> m_fd;
+
+    public:
+        inline Counters() {
+            for(size_t i = 0; i < NUM_EVENTS; i++) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = events()[i].type;
+                attr.config = events()[i].config;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                m_fd[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if(m_fd[i] >= 0) ioctl(m_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        inline ~Counters() {
+            for(int fd : m_fd) {
+                if(fd >= 0) close(fd);
+            }
+        }
+
+        Counters(const Counters&) = delete;
+        Counters& operator=(const Counters&) = delete;
+
+        inline int fd(size_t i) const {
+            return m_fd[i];
+        }
+    };
+
+    static inline const Counters& counters() {
+        static Counters s_counters;
+        return s_counters;
+    }
+
+    /// A counter value, extrapolated in case the kernel had to multiplex
+    /// more counters than the hardware provides.
+    static inline bool read_counter(int fd, double& value) {
+        uint64_t buf[3]; // value, time enabled, time running
+        if(fd < 0 || ::read(fd, buf, sizeof(buf)) != ssize_t(sizeof(buf))) {
+            return false;
+        }
+
+        value = double(buf[0]);
+        if(buf[2] > 0 && buf[2] < buf[1]) {
+            value *= double(buf[1]) / double(buf[2]);
+        }
+        return true;
+    }
+
+    std::array<double, NUM_EVENTS> m_begin;
+    std::array<bool, NUM_EVENTS> m_valid;
+
+public:
+    /// Tests whether at least one of the counters could be opened.
+    static inline bool available() {
+        for(size_t i = 0; i < NUM_EVENTS; i++) {
+            if(counters().fd(i) >= 0) return true;
+        }
+        return false;
+    }
+
+    inline PerfStatExtension() {
+        for(size_t i = 0; i < NUM_EVENTS; i++) {
+            m_valid[i] = read_counter(counters().fd(i), m_begin[i]);
+        }
+    }
+
+    virtual inline void write(json& data) override {
+        for(size_t i = 0; i < NUM_EVENTS; i++) {
+            double end;
+            if(m_valid[i] && read_counter(counters().fd(i), end)) {
+                data[events()[i].name] =
+                    (end > m_begin[i]) ? uint64_t(end - m_begin[i]) : 0;
+            }
+        }
+    }
+};
+
+}
+
+#endif // __linux__
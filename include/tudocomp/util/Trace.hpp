@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <tudocomp_stat/json.hpp>
+
+namespace tdc {
+
+/// Records a timeline of events with thread attribution in the Chrome
+/// trace event format, which can be viewed in Perfetto or
+/// `chrome://tracing`.
+///
+/// Unlike \ref StatPhase, which may only be used by a single thread,
+/// events can be recorded from any thread, e.g. from within OpenMP
+/// regions, using \ref Trace::Scope. The phase tree of a \ref StatPhase
+/// can be added with \ref add_phases if the phases were tracked with a
+/// \ref TraceStatExtension.
+///
+/// Tracing is disabled by default, in which case a scope costs a single
+/// atomic load.
+class Trace {
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct State {
+        std::atomic<bool> enabled;
+        clock::time_point epoch;
+        std::atomic<size_t> next_thread;
+
+        std::mutex mutex;
+        std::vector<json> events;
+
+        inline State() : enabled(false), epoch(clock::now()), next_thread(0) {
+        }
+    };
+
+    static inline State& state() {
+        static State s_state;
+        return s_state;
+    }
+
+    static inline void add_event(json&& event) {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.events.emplace_back(std::move(event));
+    }
+
+    static inline json complete_event(const std::string& name,
+                                      size_t tid,
+                                      uint64_t begin,
+                                      uint64_t end) {
+        json event;
+        event["name"] = name;
+        event["ph"] = "X";
+        event["pid"] = 0;
+        event["tid"] = tid;
+        event["ts"] = begin;
+        event["dur"] = (end > begin) ? end - begin : 0;
+        return event;
+    }
+
+public:
+    /// Starts recording events.
+    static inline void enable() {
+        thread_id(); // the enabling thread becomes thread 0
+        state().enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /// Tests whether events are being recorded.
+    static inline bool enabled() {
+        return state().enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the microseconds elapsed since the start of the process.
+    static inline uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            clock::now() - state().epoch).count();
+    }
+
+    /// Returns a small number identifying the calling thread,
+    /// assigned in the order in which threads first ask for it.
+    static inline size_t thread_id() {
+        static thread_local size_t s_tid =
+            state().next_thread.fetch_add(1, std::memory_order_relaxed);
+        return s_tid;
+    }
+
+    /// Records the lifetime of the scope as an event of the calling thread.
+    class Scope {
+    private:
+        bool m_active;
+        std::string m_name;
+        uint64_t m_begin;
+        json m_args;
+
+    public:
+        inline Scope(const std::string& name) : m_active(Trace::enabled()) {
+            if(m_active) {
+                m_name = name;
+                m_begin = Trace::now();
+            }
+        }
+
+        inline ~Scope() {
+            if(m_active) {
+                json event = complete_event(
+                    m_name, Trace::thread_id(), m_begin, Trace::now());
+                if(!m_args.is_null()) event["args"] = std::move(m_args);
+                Trace::add_event(std::move(event));
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /// Attaches an argument to the event.
+        template<typename T>
+        inline void log(const std::string& key, const T& value) {
+            if(m_active) m_args[key] = value;
+        }
+    };
+
+    /// Adds the phases of a \ref StatPhase tree (as returned by `to_json`)
+    /// as events. Phases without timeline information, i.e., phases
+    /// that were not tracked with a \ref TraceStatExtension, are skipped
+    /// along with their sub phases.
+    static inline void add_phases(const json& phase) {
+        if(!phase.is_object() || phase.count("traceBegin") == 0) return;
+
+        json event = complete_event(
+            phase.count("title") ? phase["title"].get<std::string>() : "",
+            phase["traceTid"].get<size_t>(),
+            phase["traceBegin"].get<uint64_t>(),
+            phase["traceEnd"].get<uint64_t>());
+
+        json args = json::object();
+        for(auto it = phase.begin(); it != phase.end(); ++it) {
+            const std::string& key = it.key();
+            if(key == "title" || key == "sub" || key.compare(0, 5, "trace") == 0) {
+                continue;
+            } else if(key == "stats" && it.value().is_array()) {
+                for(auto& stat : it.value()) {
+                    args[stat["key"].get<std::string>()] = stat["value"];
+                }
+            } else {
+                args[key] = it.value();
+            }
+        }
+        event["args"] = std::move(args);
+        add_event(std::move(event));
+
+        if(phase.count("sub")) {
+            for(auto& sub : phase["sub"]) add_phases(sub);
+        }
+    }
+
+    /// Returns all recorded events as a trace event document.
+    static inline json to_json() {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        json events = json::array();
+        const size_t num_threads = s.next_thread.load();
+        for(size_t tid = 0; tid < num_threads; tid++) {
+            json meta;
+            meta["name"] = "thread_name";
+            meta["ph"] = "M";
+            meta["pid"] = 0;
+            meta["tid"] = tid;
+            meta["args"]["name"] = (tid == 0) ? std::string("main")
+                : "thread " + std::to_string(tid);
+            events.push_back(std::move(meta));
+        }
+        for(auto& event : s.events) {
+            events.push_back(event);
+        }
+
+        json trace;
+        trace["traceEvents"] = std::move(events);
+        trace["displayTimeUnit"] = "ms";
+        return trace;
+    }
+};
+
+}
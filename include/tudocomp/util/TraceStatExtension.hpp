@@ -0,0 +1,28 @@
+#pragma once
+
+#include <tudocomp/util/Trace.hpp>
+#include <tudocomp_stat/StatPhaseExtension.hpp>
+
+namespace tdc {
+
+/// Statistics extension that stores the thread and the begin and end
+/// time of every \ref StatPhase on the clock of \ref Trace, so the phase
+/// tree can be placed on a timeline with \ref Trace::add_phases.
+class TraceStatExtension : public StatPhaseExtension {
+private:
+    size_t m_tid;
+    uint64_t m_begin;
+
+public:
+    inline TraceStatExtension()
+        : m_tid(Trace::thread_id()), m_begin(Trace::now()) {
+    }
+
+    virtual inline void write(json& data) override {
+        data["traceTid"] = m_tid;
+        data["traceBegin"] = m_begin;
+        data["traceEnd"] = Trace::now();
+    }
+};
+
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/util.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+
+namespace tdc {
+
+/// \cond INTERNAL
+namespace sais_impl {
+
+using buckets_t = std::vector<len_t>;
+
+/// Classifies the suffixes of the text as S-type (1) or L-type (0).
+///
+/// The text is virtually terminated by a sentinel at position n that is
+/// smaller than any character, so suffix n is S-type and suffix n-1 is
+/// L-type.
+template<typename text_t>
+inline void classify(const text_t& t, size_t n, BitVector& stype) {
+    DCHECK_GT(n, 0U);
+    stype = BitVector(n + 1, 0);
+    stype[n] = 1;
+    for(size_t i = n - 1; i-- > 0;) {
+        const uint64_t a = t[i];
+        const uint64_t b = t[i + 1];
+        stype[i] = (a < b) || (a == b && stype[i + 1]);
+    }
+}
+
+inline bool is_lms(const BitVector& stype, size_t i) {
+    return i > 0 && stype[i] && !stype[i - 1];
+}
+
+template<typename text_t>
+inline void count(const text_t& t, size_t n, buckets_t& cnt) {
+    std::fill(cnt.begin(), cnt.end(), 0);
+    for(size_t i = 0; i < n; ++i) {
+        DCHECK_LT(uint64_t(t[i]), cnt.size()) << "character exceeds alphabet";
+        ++cnt[t[i]];
+    }
+}
+
+/// Computes the bucket heads (end = false) or bucket ends (end = true).
+inline void buckets(const buckets_t& cnt, buckets_t& bkt, bool end) {
+    len_t sum = 0;
+    for(size_t c = 0; c < cnt.size(); ++c) {
+        sum += cnt[c];
+        bkt[c] = end ? sum : sum - cnt[c];
+    }
+}
+
+/// Induces the order of the L-type suffixes from the LMS suffixes, and
+/// then the order of the S-type suffixes from the L-type suffixes.
+template<typename text_t, typename sa_t>
+inline void induce(
+    const text_t& t, sa_t& sa, size_t n, const BitVector& stype,
+    const buckets_t& cnt, buckets_t& bkt) {
+
+    const len_t empty = n;
+
+    buckets(cnt, bkt, false);
+    // the virtual sentinel precedes all suffixes and induces suffix n-1
+    sa[bkt[t[n - 1]]++] = n - 1;
+    for(size_t i = 0; i < n; ++i) {
+        const len_t j = sa[i];
+        if(j != empty && j > 0 && !stype[j - 1]) {
+            sa[bkt[t[j - 1]]++] = j - 1;
+        }
+    }
+
+    buckets(cnt, bkt, true);
+    for(size_t i = n; i-- > 0;) {
+        const len_t j = sa[i];
+        if(j != empty && j > 0 && stype[j - 1]) {
+            sa[--bkt[t[j - 1]]] = j - 1;
+        }
+    }
+}
+
+/// Tests whether the LMS substrings starting at a and b are equal.
+template<typename text_t>
+inline bool lms_equal(
+    const text_t& t, size_t n, const BitVector& stype, len_t a, len_t b) {
+
+    for(size_t d = 0;; ++d) {
+        // the sentinel is unique
+        if(a + d == n || b + d == n) return false;
+        if(uint64_t(t[a + d]) != uint64_t(t[b + d])) return false;
+        if(stype[a + d] != stype[b + d]) return false;
+        if(d > 0 && is_lms(stype, a + d)) {
+            // both substrings end here
+            return is_lms(stype, b + d);
+        }
+    }
+}
+
+/// Constructs the suffix array sa[0..n) of t[0..n) over the alphabet
+/// [0, sigma). The entries of sa must be able to hold the value n.
+template<typename text_t, typename sa_t>
+inline void construct(const text_t& t, sa_t& sa, size_t n, size_t sigma) {
+    if(n == 0) return;
+    if(n == 1) {
+        sa[0] = 0;
+        return;
+    }
+
+    const len_t empty = n;
+
+    BitVector stype;
+    classify(t, n, stype);
+
+    buckets_t cnt(sigma);
+    buckets_t bkt(sigma);
+    count(t, n, cnt);
+
+    // sort LMS substrings by placing the LMS suffixes at their bucket ends
+    for(size_t i = 0; i < n; ++i) sa[i] = empty;
+    buckets(cnt, bkt, true);
+    for(size_t i = 1; i < n; ++i) {
+        if(is_lms(stype, i)) sa[--bkt[t[i]]] = i;
+    }
+    induce(t, sa, n, stype, cnt, bkt);
+
+    // compact the sorted LMS substrings into sa[0..n1)
+    size_t n1 = 0;
+    for(size_t i = 0; i < n; ++i) {
+        const len_t j = sa[i];
+        if(j != empty && is_lms(stype, j)) sa[n1++] = j;
+    }
+    DCHECK_LE(n1, n / 2);
+
+    // name the LMS substrings, the name of the LMS substring starting at
+    // position j is stored at sa[n1 + j/2]
+    for(size_t i = n1; i < n; ++i) sa[i] = empty;
+    size_t names = 0;
+    for(size_t i = 0; i < n1; ++i) {
+        const len_t j = sa[i];
+        if(i == 0 || !lms_equal(t, n, stype, sa[i - 1], j)) ++names;
+        sa[n1 + j / 2] = names - 1;
+    }
+
+    // the reduced text consists of the names in text order
+    DynamicIntVector t1(n1, 0, bits_for(names));
+    for(size_t i = n1, k = 0; i < n; ++i) {
+        const len_t x = sa[i];
+        if(x != empty) t1[k++] = x;
+    }
+
+    // sort the LMS suffixes using the reduced text
+    DynamicIntVector sa1(n1, 0, bits_for(n1));
+    if(names < n1) {
+        construct(t1, sa1, n1, names);
+    } else {
+        // all names are unique
+        for(size_t i = 0; i < n1; ++i) sa1[t1[i]] = i;
+    }
+    t1 = DynamicIntVector();
+
+    // map the reduced suffixes back to their text positions, which are
+    // stored in sa[n-n1..n) temporarily
+    for(size_t i = 1, k = n - n1; i < n; ++i) {
+        if(is_lms(stype, i)) sa[k++] = i;
+    }
+    for(size_t i = 0; i < n1; ++i) {
+        sa[i] = len_t(sa[n - n1 + sa1[i]]);
+    }
+    sa1 = DynamicIntVector();
+
+    // place the sorted LMS suffixes at their bucket ends, in reverse order
+    // so no unprocessed entry gets overwritten, and induce the rest
+    for(size_t i = n1; i < n; ++i) sa[i] = empty;
+    buckets(cnt, bkt, true);
+    for(size_t i = n1; i-- > 0;) {
+        const len_t j = sa[i];
+        sa[i] = empty;
+        sa[--bkt[t[j]]] = j;
+    }
+    induce(t, sa, n, stype, cnt, bkt);
+}
+
+}
+/// \endcond
+
+/// \brief Constructs the suffix array of a text over an integer alphabet
+///        using SA-IS.
+///
+/// In contrast to \ref divsufsort, the text does not need to be terminated
+/// by a sentinel, and the suffix array does not need an additional sign bit.
+/// The end of the text is considered smaller than any character.
+///
+/// \param text The text. Its characters must be in the range [0, sigma).
+/// \param sa The suffix array to construct, of at least n entries of at
+///           least \c bits_for(n) bits each.
+/// \param n The length of the text.
+/// \param sigma The size of the alphabet.
+template<typename text_t, typename sa_t>
+inline void sais(const text_t& text, sa_t& sa, size_t n, size_t sigma) {
+    sais_impl::construct(text, sa, n, sigma);
+}
+
+/// \brief Constructs the suffix array of an integer string using SA-IS.
+///
+/// The alphabet is assumed to be [0, max], where max is the greatest
+/// value contained in the text.
+///
+/// \param text The text.
+/// \return The suffix array, whose entries are \c bits_for(n) bits wide.
+inline DynamicIntVector sais(const DynamicIntVector& text) {
+    const size_t n = text.size();
+
+    uint64_t max = 0;
+    for(size_t i = 0; i < n; ++i) max = std::max<uint64_t>(max, text[i]);
+
+    DynamicIntVector sa(n, 0, bits_for(n));
+    sais_impl::construct(text, sa, n, n ? max + 1 : 0);
+    return sa;
+}
+
+}
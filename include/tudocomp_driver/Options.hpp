@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <vector>
@@ -15,20 +16,31 @@ constexpr int OPT_HELP   = 1000;
 constexpr int OPT_RAW    = 1001;
 constexpr int OPT_STDIN  = 1002;
 constexpr int OPT_STDOUT = 1003;
+constexpr int OPT_EXTRACT = 1004;
+constexpr int OPT_BATCH  = 1005;
+constexpr int OPT_BENCH  = 1006;
+constexpr int OPT_PERF   = 1007;
+constexpr int OPT_TRACE  = 1008;
 
 constexpr option OPTIONS[] = {
     {"algorithm",  required_argument, nullptr, 'a'},
+    {"batch",      required_argument, nullptr, OPT_BATCH},
+    {"bench",      optional_argument, nullptr, OPT_BENCH},
     {"decompress", no_argument,       nullptr, 'd'},
     {"escape",     required_argument, nullptr, 'e'},
+    {"extract",    required_argument, nullptr, OPT_EXTRACT},
     {"force",      no_argument,       nullptr, 'f'},
     {"generator",  required_argument, nullptr, 'g'},
     {"help",       no_argument,       nullptr, OPT_HELP},
     {"list",       optional_argument, nullptr, 'l'},
     {"output",     required_argument, nullptr, 'o'},
+    {"perf",       no_argument,       nullptr, OPT_PERF},
     {"prefix",     required_argument, nullptr, 'p'},
     {"sentinel",   no_argument,       nullptr, '0'},
     {"stats",      optional_argument, nullptr, 's'},
     {"statfile",   required_argument, nullptr, 'S'},
+    {"threads",    required_argument, nullptr, 'j'},
+    {"trace",      required_argument, nullptr, OPT_TRACE},
     {"version",    no_argument,       nullptr, 'v'},
     {"raw",        no_argument,       nullptr, OPT_RAW},
     {"usestdin",   no_argument,       nullptr, OPT_STDIN},
@@ -52,12 +64,16 @@ public:
             << setw(11) << "--usestdin" << "(2)" << endl;
         out << setw(7) << "or: " << cmd << " [OPTION] "
             << setw(11) << "-g GENERATOR" << "(3)" << endl;
+        out << setw(7) << "or: " << cmd << " [OPTION] "
+            << setw(11) << "--batch=LIST" << "(4)" << endl;
 
         // Brief description
         out << endl;
         out << "Compresses or decompresses a file (1), an input received via stdin (2) or a" << endl;
         out << "generated string (3). Depending on the selected input, an output (either a" << endl;
         out << "file or stdout) may need to be specified." << endl;
+        out << "In batch mode (4), every file named in LIST (one per line) or contained in" << endl;
+        out << "the directory LIST is processed and written next to its input." << endl;
 
         // Options
         out << endl;
@@ -75,6 +91,21 @@ public:
             << endl << setw(W_INDENT) << "" << "(use -l for more information)"
             << endl;
 
+        // --batch
+        out << right << setw(W_NOSF) << ""
+            << left << setw(W_LF) << "--batch=LIST"
+            << "process all files listed in LIST, or contained"
+            << endl << setw(W_INDENT) << "" << "in the directory LIST"
+            << endl;
+
+        // --bench
+        out << right << setw(W_NOSF) << ""
+            << left << setw(W_LF) << "--bench[=N]"
+            << "run N warmup and N measured round-trips in memory"
+            << endl << setw(W_INDENT) << "" << "and print timings in JSON format (default N=5),"
+            << endl << setw(W_INDENT) << "" << "latencies in ms and throughput in MiB/s"
+            << endl;
+
         // -d, --decompress
         out << right << setw(W_SF) << "-d" << ", "
             << left << setw(W_LF) << "--decompress"
@@ -120,6 +151,13 @@ public:
             << "write output to FILE."
             << endl;
 
+        // --perf
+        out << right << setw(W_NOSF) << ""
+            << left << setw(W_LF) << "--perf"
+            << "record hardware performance counters for each"
+            << endl << setw(W_INDENT) << "" << "phase in the statistics (Linux only)"
+            << endl;
+
         // -p, --prefix=BYTES
         out << right << setw(W_SF) << "-p" << ", "
             << left << setw(W_LF) << "--prefix=BYTES"
@@ -138,6 +176,26 @@ public:
             << "write stats to FILE."
             << endl;
 
+        // --trace
+        out << right << setw(W_NOSF) << ""
+            << left << setw(W_LF) << "--trace=FILE"
+            << "write a timeline of all phases and threads to FILE"
+            << endl << setw(W_INDENT) << "" << "(Chrome trace event format)"
+            << endl;
+
+        // --extract
+        out << right << setw(W_NOSF) << ""
+            << left << setw(W_LF) << "--extract=OFFSET,LENGTH"
+            << "decompress only LENGTH bytes starting at OFFSET"
+            << endl << setw(W_INDENT) << "" << "(implies --decompress)"
+            << endl;
+
+        // -j, --threads
+        out << right << setw(W_SF) << "-j" << ", "
+            << left << setw(W_LF) << "--threads=N"
+            << "use N worker threads in batch mode"
+            << endl;
+
         // --help
         out << right << setw(W_NOSF) << ""
             << left << setw(W_LF) << "--help"
@@ -211,12 +269,23 @@ private:
     std::string m_generator;
     size_t m_prefix;
 
+    std::string m_batch;
+    size_t m_threads;
+
+    size_t m_bench;
+
     bool m_raw;
     bool m_decompress;
 
+    bool m_extract;
+    size_t m_extract_offset;
+    size_t m_extract_length;
+
     bool m_stats;
+    bool m_perf;
     std::string m_stats_title;
     std::string m_stat_file;
+    std::string m_trace;
 
     std::vector<std::string> m_remaining;
 
@@ -236,14 +305,22 @@ public:
         m_stdin(false),
         m_stdout(false),
         m_prefix(0),
+        m_threads(1),
+        m_bench(0),
         m_raw(false),
         m_decompress(false),
-        m_stats(false)
+        m_extract(false),
+        m_extract_offset(0),
+        m_extract_length(0),
+        m_stats(false),
+        m_perf(false)
     {
         int c, option_index = 0;
         std::string escape;
+        std::string extract;
+        size_t sep;
 
-        while((c = getopt_long(argc, argv, "O:V:L:a:df0e:g:lo:p:s::v",
+        while((c = getopt_long(argc, argv, "O:V:L:a:df0e:g:j:lo:p:s::v",
             OPTIONS, &option_index)) != -1) {
 
             switch(c) {
@@ -275,6 +352,10 @@ public:
                     m_generator = std::string(optarg);
                     break;
 
+                case 'j': // --threads=<optarg>
+                    m_threads = std::max(1, std::atoi(optarg));
+                    break;
+
                 case 'l': // --list
                     m_list = true;
                     if(optarg) m_list_algorithm = std::string(optarg);
@@ -329,6 +410,36 @@ public:
                     m_stdout = true;
                     break;
 
+                case OPT_BATCH: // --batch=<optarg>
+                    m_batch = std::string(optarg);
+                    break;
+
+                case OPT_BENCH: // --bench=[optarg]
+                    m_bench = optarg ? std::max(1, std::atoi(optarg)) : 5;
+                    break;
+
+                case OPT_TRACE: // --trace=<optarg>
+                    m_trace = std::string(optarg);
+                    break;
+
+                case OPT_PERF: // --perf
+                    m_perf = true;
+                    break;
+
+                case OPT_EXTRACT: // --extract=<offset>,<length>
+                    extract = std::string(optarg);
+                    sep = extract.find(',');
+                    if(sep == std::string::npos) {
+                        std::cerr << "--extract expects OFFSET,LENGTH" << std::endl;
+                        m_unknown_options = true;
+                    } else {
+                        m_extract = true;
+                        m_decompress = true;
+                        m_extract_offset = tdc::parse_bytes(extract.substr(0, sep));
+                        m_extract_length = tdc::parse_bytes(extract.substr(sep + 1));
+                    }
+                    break;
+
                 case '?': // unknown option
                     m_unknown_options = true;
                     break;
@@ -368,12 +479,23 @@ public:
 
     const size_t& prefix = m_prefix;
 
+    const std::string& batch = m_batch;
+    const size_t& threads = m_threads;
+
+    const size_t& bench = m_bench;
+
     const bool& raw = m_raw;
     const bool& decompress = m_decompress;
 
+    const bool& extract = m_extract;
+    const size_t& extract_offset = m_extract_offset;
+    const size_t& extract_length = m_extract_length;
+
     const bool& stats = m_stats;
+    const bool& perf = m_perf;
     const std::string& stat_file = m_stat_file;
     const std::string& stats_title = m_stats_title;
+    const std::string& trace = m_trace;
 
     const std::vector<std::string>& remaining = m_remaining;
 };
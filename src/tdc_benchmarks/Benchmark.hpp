@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <tudocomp_stat/json.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+/// \cond INTERNAL
+/// \brief Contains the microbenchmark suite.
+///
+/// Every benchmark group is a function that receives the suite and the
+/// benchmark inputs, and measures its workloads via \ref Suite::run.
+namespace tdc_benchmarks {
+
+using tdc::json;
+
+/// A named benchmark input text.
+struct BenchInput {
+    std::string name;
+    std::string text;
+};
+
+/// Measures the time of the part of a repetition that is enclosed
+/// in \ref start and \ref stop.
+class Stopwatch {
+    using clk = std::chrono::high_resolution_clock;
+
+    clk::time_point m_start;
+    double m_elapsed = 0; // milliseconds
+
+public:
+    inline void start() {
+        m_start = clk::now();
+    }
+
+    inline void stop() {
+        m_elapsed += std::chrono::duration<double, std::milli>(
+            clk::now() - m_start).count();
+    }
+
+    inline double elapsed() const {
+        return m_elapsed;
+    }
+};
+
+/// Prevents the compiler from optimizing away the computation of a value.
+template<typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Suite {
+    size_t m_repeats;
+    std::string m_filter;
+    json m_results = json::array();
+
+public:
+    inline Suite(size_t repeats, const std::string& filter)
+        : m_repeats(std::max(repeats, size_t(1))), m_filter(filter) {
+    }
+
+    /// \brief Runs a benchmark.
+    ///
+    /// The function is called once per repetition with a \ref Stopwatch
+    /// that it has to start and stop around the measured work. The
+    /// median time is used to compute the throughput of \c bytes in MiB/s
+    /// and the time per operation of \c ops.
+    template<typename F>
+    inline void run(const std::string& group,
+                    const std::string& name,
+                    const BenchInput& input,
+                    size_t bytes,
+                    size_t ops,
+                    F f) {
+
+        const std::string id = group + "/" + name + "/" + input.name;
+        if(!m_filter.empty() && id.find(m_filter) == std::string::npos) {
+            return;
+        }
+
+        std::vector<double> times;
+        for(size_t i = 0; i < m_repeats; i++) {
+            Stopwatch sw;
+            f(sw);
+            times.push_back(sw.elapsed());
+        }
+        std::sort(times.begin(), times.end());
+
+        const double median = times[times.size() / 2];
+
+        json r;
+        r["group"] = group;
+        r["name"] = name;
+        r["input"] = input.name;
+        r["bytes"] = bytes;
+        r["ops"] = ops;
+        r["repeats"] = m_repeats;
+        r["min"] = times.front();
+        r["median"] = median;
+        r["max"] = times.back();
+        r["throughput_mib_s"] = (median == 0) ? 0.0 :
+            (double(bytes) / (1024.0 * 1024.0)) / (median / 1000.0);
+        r["nsPerOp"] = (ops == 0) ? 0.0 : (median * 1e6) / double(ops);
+        m_results.push_back(r);
+    }
+
+    inline const json& results() const {
+        return m_results;
+    }
+};
+
+// benchmark groups
+void bench_coders(Suite& suite, const std::vector<BenchInput>& inputs);
+void bench_lz_tries(Suite& suite, const std::vector<BenchInput>& inputs);
+void bench_bit_io(Suite& suite, const std::vector<BenchInput>& inputs);
+void bench_rank_select(Suite& suite, const std::vector<BenchInput>& inputs);
+void bench_ds_providers(Suite& suite, const std::vector<BenchInput>& inputs);
+
+} // namespace tdc_benchmarks
+/// \endcond
@@ -0,0 +1,67 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tudocomp/io.hpp>
+
+#include "Benchmark.hpp"
+
+namespace tdc_benchmarks {
+
+using namespace tdc;
+
+void bench_bit_io(Suite& suite, const std::vector<BenchInput>& inputs) {
+    for(auto& input : inputs) {
+        const std::string& text = input.text;
+        const size_t n = text.size();
+
+        // single bits, one per bit of the text
+        std::string encoded;
+        suite.run("bit_io", "write_bits", input, n, 8 * n, [&](Stopwatch& sw) {
+            std::stringstream ss;
+            {
+                Output output(ss);
+                sw.start();
+                BitOStream out(output);
+                for(uint8_t c : text) {
+                    for(size_t i = 0; i < 8; i++) out.write_bit((c >> i) & 1);
+                }
+            }
+            sw.stop();
+            encoded = ss.str();
+        });
+
+        suite.run("bit_io", "read_bits", input, n, 8 * n, [&](Stopwatch& sw) {
+            Input input(encoded);
+            sw.start();
+            BitIStream in(input);
+            for(size_t i = 0; i < 8 * n; i++) do_not_optimize(in.read_bit());
+            sw.stop();
+        });
+
+        // integers of varying width, one per character of the text
+        suite.run("bit_io", "write_ints", input, n, n, [&](Stopwatch& sw) {
+            std::stringstream ss;
+            {
+                Output output(ss);
+                sw.start();
+                BitOStream out(output);
+                for(uint8_t c : text) out.write_int(c, 1 + (c % 8));
+            }
+            sw.stop();
+            encoded = ss.str();
+        });
+
+        suite.run("bit_io", "read_ints", input, n, n, [&](Stopwatch& sw) {
+            Input input(encoded);
+            sw.start();
+            BitIStream in(input);
+            for(uint8_t c : text) {
+                do_not_optimize(in.read_int<uint8_t>(1 + (c % 8)));
+            }
+            sw.stop();
+        });
+    }
+}
+
+} // namespace tdc_benchmarks
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tudocomp/io.hpp>
+#include <tudocomp/Literal.hpp>
+#include <tudocomp/Range.hpp>
+
+#include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/ArithmeticCoder.hpp>
+#include <tudocomp/coders/BinaryCoder.hpp>
+#include <tudocomp/coders/EliasDeltaCoder.hpp>
+#include <tudocomp/coders/EliasGammaCoder.hpp>
+#include <tudocomp/coders/HuffmanCoder.hpp>
+#include <tudocomp/coders/RiceCoder.hpp>
+#include <tudocomp/coders/SigmaCoder.hpp>
+#include <tudocomp/coders/SLEIntCoder.hpp>
+#include <tudocomp/coders/SLEKmerCoder.hpp>
+#include <tudocomp/coders/TernaryCoder.hpp>
+
+#include "Benchmark.hpp"
+
+namespace tdc_benchmarks {
+
+using namespace tdc;
+
+/// The integers are bounded like the offsets of a sliding window.
+constexpr size_t INT_WINDOW = 4096;
+
+/// Derives an integer stream resembling LZ77 factor references
+/// from the text.
+static std::vector<size_t> integer_workload(const std::string& text) {
+    std::vector<size_t> ints;
+    ints.reserve(text.size());
+
+    size_t x = 0;
+    for(size_t i = 0; i < text.size(); i++) {
+        x = (x * 31 + uint8_t(text[i])) % std::min(i + 1, INT_WINDOW);
+        ints.push_back(x);
+    }
+    return ints;
+}
+
+template<typename coder_t>
+static void bench_coder(Suite& suite,
+                        const std::string& name,
+                        const BenchInput& input,
+                        const std::string& options = "") {
+
+    const std::string& text = input.text;
+    const size_t n = text.size();
+    const auto ints = integer_workload(text);
+    const Range int_r(INT_WINDOW);
+
+    // literals
+    std::string encoded;
+    suite.run("coder_encode_literals", name, input, n, n, [&](Stopwatch& sw) {
+        std::stringstream ss;
+        {
+            Output out(ss);
+            sw.start();
+            typename coder_t::Encoder coder(
+                coder_t::meta().config(options), out, ViewLiterals(text));
+
+            for(char c : text) coder.encode(uliteral_t(c), literal_r);
+        }
+        sw.stop();
+        encoded = ss.str();
+    });
+
+    suite.run("coder_decode_literals", name, input, n, n, [&](Stopwatch& sw) {
+        Input in(encoded);
+        sw.start();
+        typename coder_t::Decoder decoder(coder_t::meta().config(options), in);
+        for(size_t i = 0; i < n; i++) {
+            do_not_optimize(decoder.template decode<uliteral_t>(literal_r));
+        }
+        sw.stop();
+    });
+
+    // integers
+    suite.run("coder_encode_ints", name, input, n, n, [&](Stopwatch& sw) {
+        std::stringstream ss;
+        {
+            Output out(ss);
+            sw.start();
+            typename coder_t::Encoder coder(
+                coder_t::meta().config(options), out, ViewLiterals(text));
+
+            for(size_t x : ints) coder.encode(x, int_r);
+        }
+        sw.stop();
+        encoded = ss.str();
+    });
+
+    suite.run("coder_decode_ints", name, input, n, n, [&](Stopwatch& sw) {
+        Input in(encoded);
+        sw.start();
+        typename coder_t::Decoder decoder(coder_t::meta().config(options), in);
+        for(size_t i = 0; i < n; i++) {
+            do_not_optimize(decoder.template decode<size_t>(int_r));
+        }
+        sw.stop();
+    });
+}
+
+void bench_coders(Suite& suite, const std::vector<BenchInput>& inputs) {
+    for(auto& input : inputs) {
+        bench_coder<ASCIICoder>(suite, "ascii", input);
+        bench_coder<ArithmeticCoder>(suite, "arithmetic", input);
+        bench_coder<BinaryCoder>(suite, "binary", input);
+        bench_coder<EliasDeltaCoder>(suite, "delta", input);
+        bench_coder<EliasGammaCoder>(suite, "gamma", input);
+        bench_coder<HuffmanCoder>(suite, "huffman", input);
+        bench_coder<RiceCoder>(suite, "rice", input, "8");
+        bench_coder<SigmaCoder>(suite, "sigma", input);
+        bench_coder<SLEIntCoder>(suite, "sle_int", input);
+        bench_coder<SLEKmerCoder>(suite, "sle_kmer", input);
+        bench_coder<TernaryCoder>(suite, "ternary", input);
+    }
+}
+
+} // namespace tdc_benchmarks
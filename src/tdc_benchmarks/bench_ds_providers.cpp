@@ -0,0 +1,106 @@
+#include <string>
+#include <vector>
+
+#include <tudocomp/ds/DSManager.hpp>
+#include <tudocomp/ds/providers/BlockedISAFromSA.hpp>
+#include <tudocomp/ds/providers/BlockedPhiFromSA.hpp>
+#include <tudocomp/ds/providers/DivSufSort.hpp>
+#include <tudocomp/ds/providers/ISAFromSA.hpp>
+#include <tudocomp/ds/providers/LCPFromPLCP.hpp>
+#include <tudocomp/ds/providers/PhiAlgorithm.hpp>
+#include <tudocomp/ds/providers/PhiFromSA.hpp>
+
+#include "Benchmark.hpp"
+
+namespace tdc_benchmarks {
+
+using namespace tdc;
+
+using dsmanager_t = DSManager<
+    DivSufSort, ISAFromSA, PhiFromSA, PhiAlgorithm, LCPFromPLCP>;
+
+using blocked_dsmanager_t = DSManager<
+    DivSufSort, BlockedISAFromSA, BlockedPhiFromSA, PhiAlgorithm, LCPFromPLCP>;
+
+// selects the manager type of a benchmark
+template<typename T> struct manager_tag { using type = T; };
+
+void bench_ds_providers(Suite& suite, const std::vector<BenchInput>& inputs) {
+    for(auto& input : inputs) {
+        // the providers require a sentinel that does not occur in the text
+        std::string text = input.text;
+        for(auto& c : text) if(c == 0) c = 1;
+        text.push_back(0);
+
+        const View view(text);
+        const size_t bytes = input.text.size();
+
+        // construct one data structure after the other, so every
+        // measurement only covers the work of a single provider
+        auto bench_with = [&](auto tag, const std::string& config,
+                              const std::string& name, auto construct_deps,
+                              auto construct) {
+            using manager_t = typename decltype(tag)::type;
+
+            suite.run("ds_provider", name, input, bytes, 1,
+                [&](Stopwatch& sw) {
+
+                manager_t dsman(manager_t::meta().config(config), view);
+                construct_deps(dsman);
+
+                sw.start();
+                construct(dsman);
+                sw.stop();
+            });
+        };
+
+        auto bench = [&](const std::string& name, auto construct_deps,
+                                                  auto construct) {
+            bench_with(manager_tag<dsmanager_t>(), "",
+                name, construct_deps, construct);
+        };
+
+        auto none = [](auto&) {};
+        auto sa = [](auto& dsman) {
+            dsman.template construct<ds::SUFFIX_ARRAY>();
+        };
+        auto sa_phi = [](auto& dsman) {
+            dsman.template construct<ds::SUFFIX_ARRAY>();
+            dsman.template construct<ds::PHI_ARRAY>();
+        };
+        auto sa_plcp = [](auto& dsman) {
+            dsman.template construct<ds::SUFFIX_ARRAY>();
+            dsman.template construct<ds::PLCP_ARRAY>();
+        };
+        auto isa = [](auto& dsman) {
+            dsman.template construct<ds::INVERSE_SUFFIX_ARRAY>();
+        };
+        auto phi = [](auto& dsman) {
+            dsman.template construct<ds::PHI_ARRAY>();
+        };
+
+        bench("divsufsort_sa", none, sa);
+        bench("isa_from_sa", sa, isa);
+        bench("phi_from_sa", sa, phi);
+        bench("phi_algorithm_plcp", sa_phi, [](auto& dsman) {
+            dsman.template construct<ds::PLCP_ARRAY>();
+        });
+        bench("lcp_from_plcp", sa_plcp, [](auto& dsman) {
+            dsman.template construct<ds::LCP_ARRAY>();
+        });
+
+        // cache-blocked scatter, sequential and parallel
+        // (blocking only takes effect from radix_scatter::MIN_SIZE on)
+        const auto blocked = manager_tag<blocked_dsmanager_t>();
+        const std::string seq = "providers=[divsufsort(), "
+            "blocked_isa(parallel=\"false\"), blocked_phi(parallel=\"false\"), "
+            "phi_algorithm(), lcp()]";
+
+        bench_with(blocked, seq, "blocked_isa_from_sa", sa, isa);
+        bench_with(blocked, seq, "blocked_phi_from_sa", sa, phi);
+        bench_with(blocked, "", "blocked_isa_from_sa_parallel", sa, isa);
+        bench_with(blocked, "", "blocked_phi_from_sa_parallel", sa, phi);
+    }
+}
+
+} // namespace tdc_benchmarks
@@ -0,0 +1,68 @@
+#include <string>
+#include <vector>
+
+#include <tudocomp/Algorithm.hpp>
+
+#include <tudocomp/compressors/lz_trie/BinarySortedTrie.hpp>
+#include <tudocomp/compressors/lz_trie/BinaryTrie.hpp>
+#include <tudocomp/compressors/lz_trie/CedarTrie.hpp>
+#include <tudocomp/compressors/lz_trie/CompactHashTrie.hpp>
+#include <tudocomp/compressors/lz_trie/ExtHashTrie.hpp>
+#include <tudocomp/compressors/lz_trie/HashTrie.hpp>
+#include <tudocomp/compressors/lz_trie/HashTriePlus.hpp>
+#include <tudocomp/compressors/lz_trie/JudyTrie.hpp>
+#include <tudocomp/compressors/lz_trie/RollingTrie.hpp>
+#include <tudocomp/compressors/lz_trie/RollingTriePlus.hpp>
+#include <tudocomp/compressors/lz_trie/TernaryTrie.hpp>
+
+#include "Benchmark.hpp"
+
+namespace tdc_benchmarks {
+
+using namespace tdc;
+using namespace tdc::lz_trie;
+
+/// Measures find_or_insert under the workload of an LZ78 factorization,
+/// which restarts at the root after every inserted node.
+template<typename trie_t>
+static void bench_trie(Suite& suite,
+                       const std::string& name,
+                       const BenchInput& input) {
+
+    const std::string& text = input.text;
+    suite.run("lz_trie_lz78", name, input, text.size(), text.size(),
+        [&](Stopwatch& sw) {
+
+        sw.start();
+        auto trie = Algorithm::instance<trie_t>(text.size());
+        trie->add_rootnode(0);
+
+        auto node = trie->get_rootnode(0);
+        for(uint8_t c : text) {
+            auto child = trie->find_or_insert(node, c);
+            node = child.is_new() ? trie->get_rootnode(0) : child;
+        }
+        do_not_optimize(trie->size());
+        sw.stop();
+    });
+}
+
+void bench_lz_tries(Suite& suite, const std::vector<BenchInput>& inputs) {
+    for(auto& input : inputs) {
+        bench_trie<BinarySortedTrie>(suite, "binary_sorted", input);
+        bench_trie<BinaryTrie>(suite, "binary", input);
+        bench_trie<CedarTrie>(suite, "cedar", input);
+        bench_trie<CompactHashTrie<>>(suite, "compact_hash", input);
+        bench_trie<ExtHashTrie>(suite, "ext_hash", input);
+        bench_trie<HashTrie<>>(suite, "hash", input);
+        bench_trie<HashTriePlus<>>(suite, "hash_plus", input);
+#ifdef JUDY_H_AVAILABLE
+        bench_trie<JudyTrie>(suite, "judy", input);
+#endif
+        bench_trie<RollingTrie<>>(suite, "rolling", input);
+        bench_trie<RollingTriePlus<>>(suite, "rolling_plus", input);
+        bench_trie<TernaryTrie>(suite, "ternary", input);
+    }
+}
+
+} // namespace tdc_benchmarks
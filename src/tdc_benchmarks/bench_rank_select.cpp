@@ -0,0 +1,107 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/Rank.hpp>
+#include <tudocomp/ds/RankSelect.hpp>
+#include <tudocomp/ds/Select.hpp>
+
+#include "Benchmark.hpp"
+
+namespace tdc_benchmarks {
+
+using namespace tdc;
+
+constexpr size_t NUM_QUERIES = 1'000'000;
+
+void bench_rank_select(Suite& suite, const std::vector<BenchInput>& inputs) {
+    for(auto& input : inputs) {
+        const std::string& text = input.text;
+
+        // bit vector of the text's bits
+        BitVector bv(8 * text.size());
+        for(size_t i = 0; i < text.size(); i++) {
+            for(size_t j = 0; j < 8; j++) bv[8 * i + j] = (text[i] >> j) & 1;
+        }
+        const size_t bytes = text.size();
+
+        suite.run("rank_select", "rank_construct", input, bytes, 1,
+            [&](Stopwatch& sw) {
+
+            sw.start();
+            Rank rank(bv);
+            do_not_optimize(rank(bv.size() - 1));
+            sw.stop();
+        });
+
+        suite.run("rank_select", "select1_construct", input, bytes, 1,
+            [&](Stopwatch& sw) {
+
+            sw.start();
+            Select1 select(bv);
+            do_not_optimize(select(1));
+            sw.stop();
+        });
+
+        suite.run("rank_select", "rank_select_construct", input, bytes, 1,
+            [&](Stopwatch& sw) {
+
+            sw.start();
+            RankSelect rs(bv);
+            do_not_optimize(rs(bv.size() - 1));
+            sw.stop();
+        });
+
+        Rank rank(bv);
+        Select1 select(bv);
+        RankSelect rs(bv);
+        const size_t ones = rank(bv.size() - 1);
+
+        // random queries with a fixed seed
+        std::vector<size_t> rank_q(NUM_QUERIES), select_q(NUM_QUERIES);
+        {
+            std::mt19937_64 gen(42);
+            for(size_t i = 0; i < NUM_QUERIES; i++) {
+                rank_q[i] = gen() % bv.size();
+                select_q[i] = (ones > 0) ? 1 + gen() % ones : 1;
+            }
+        }
+
+        suite.run("rank_select", "rank1_query", input, bytes, NUM_QUERIES,
+            [&](Stopwatch& sw) {
+
+            sw.start();
+            for(size_t x : rank_q) do_not_optimize(rank(x));
+            sw.stop();
+        });
+
+        suite.run("rank_select", "rank_select_rank1_query", input, bytes,
+            NUM_QUERIES, [&](Stopwatch& sw) {
+
+            sw.start();
+            for(size_t x : rank_q) do_not_optimize(rs(x));
+            sw.stop();
+        });
+
+        if(ones > 0) {
+            suite.run("rank_select", "select1_query", input, bytes, NUM_QUERIES,
+                [&](Stopwatch& sw) {
+
+                sw.start();
+                for(size_t k : select_q) do_not_optimize(select(k));
+                sw.stop();
+            });
+
+            suite.run("rank_select", "rank_select_select1_query", input, bytes,
+                NUM_QUERIES, [&](Stopwatch& sw) {
+
+                sw.start();
+                for(size_t k : select_q) do_not_optimize(rs.select1(k));
+                sw.stop();
+            });
+        }
+    }
+}
+
+} // namespace tdc_benchmarks
@@ -0,0 +1,114 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+#include <tudocomp/util.hpp>
+#include <tudocomp/generators/FibonacciGenerator.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+#include <tudocomp/generators/RunRichGenerator.hpp>
+#include <tudocomp/generators/ThueMorseGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace tdc_benchmarks;
+
+constexpr option OPTIONS[] = {
+    {"filter",  required_argument, nullptr, 'f'},
+    {"help",    no_argument,       nullptr, 'h'},
+    {"repeats", required_argument, nullptr, 'r'},
+    {"size",    required_argument, nullptr, 's'},
+    {0, 0, 0, 0}
+};
+
+static void print_usage(const std::string& cmd) {
+    std::cout
+        << "Usage: " << cmd << " [OPTION] [FILE]...\n\n"
+        << "Runs the microbenchmarks on generated inputs and the given files\n"
+        << "and prints the results in JSON format.\n\n"
+        << "Options:\n"
+        << "  -f, --filter=TEXT   only run benchmarks whose group/name/input contains TEXT\n"
+        << "  -r, --repeats=N     repeat every benchmark N times (default 5)\n"
+        << "  -s, --size=BYTES    length of the generated inputs (default 1Mi)\n"
+        << "  -h, --help          display this help\n";
+}
+
+/// Generates the shortest string of a growing family that has at least
+/// the given length, and cuts it down to that length.
+template<typename F>
+static std::string generate_prefix(F generate, size_t n) {
+    std::string s;
+    for(size_t k = 1; s.size() < n; k++) {
+        s = generate(k);
+    }
+    s.resize(n);
+    return s;
+}
+
+int main(int argc, char** argv) {
+    size_t repeats = 5;
+    size_t size = 1024 * 1024;
+    std::string filter;
+
+    int c, option_index = 0;
+    while((c = getopt_long(argc, argv, "f:hr:s:",
+        OPTIONS, &option_index)) != -1) {
+
+        switch(c) {
+            case 'f': filter = std::string(optarg); break;
+            case 'r': repeats = std::max(1, std::atoi(optarg)); break;
+            case 's': size = tdc::parse_bytes(optarg); break;
+            case 'h': print_usage(argv[0]); return 0;
+            default:  print_usage(argv[0]); return 2;
+        }
+    }
+
+    // inputs: generated texts with a fixed seed for reproducibility
+    std::vector<BenchInput> inputs {
+        { "random", tdc::RandomUniformGenerator::generate(size, 42, 'a', 'z') },
+        { "fibonacci", generate_prefix(
+            [](size_t k){ return tdc::FibonacciGenerator::generate(k); }, size) },
+        { "run_rich", generate_prefix(
+            [](size_t k){ return tdc::RunRichGenerator::generate(k); }, size) },
+        { "thue_morse", generate_prefix(
+            [](size_t k){ return tdc::ThueMorseGenerator::generate(k); }, size) },
+    };
+
+    // inputs: files
+    while(optind < argc) {
+        std::string path(argv[optind++]);
+        std::ifstream in(path, std::ios::binary);
+        if(!in) {
+            std::cerr << "cannot open input file: " << path << std::endl;
+            return 1;
+        }
+
+        std::stringstream ss;
+        ss << in.rdbuf();
+        if(ss.str().empty()) {
+            std::cerr << "skipping empty input file: " << path << std::endl;
+            continue;
+        }
+        inputs.push_back(BenchInput { path, ss.str() });
+    }
+
+    Suite suite(repeats, filter);
+    bench_coders(suite, inputs);
+    bench_lz_tries(suite, inputs);
+    bench_bit_io(suite, inputs);
+    bench_rank_select(suite, inputs);
+    bench_ds_providers(suite, inputs);
+
+    json meta;
+    meta["repeats"] = repeats;
+    meta["generatedSize"] = size;
+    meta["filter"] = filter;
+
+    json report = {{"meta", meta}, {"results", suite.results()}};
+    std::cout << report << std::endl;
+    return 0;
+}
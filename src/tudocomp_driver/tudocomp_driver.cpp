@@ -1,15 +1,22 @@
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <dirent.h>
+#include <sys/resource.h>
+
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/compressors/ChainCompressor.hpp>
 
@@ -18,6 +25,9 @@
 #include <tudocomp/version.hpp>
 
 #include <tudocomp/util/ASCIITable.hpp>
+#include <tudocomp/util/PerfStatExtension.hpp>
+#include <tudocomp/util/Trace.hpp>
+#include <tudocomp/util/TraceStatExtension.hpp>
 
 #include <tudocomp_driver/Options.hpp>
 #include <tudocomp_driver/Registry.hpp>
@@ -51,6 +61,424 @@ static int bad_usage(const char* cmd, const std::string& message) {
     return 2;
 }
 
+/// Reads the algorithm header of a compressed input and slices it off.
+static std::string read_header(Input& inp) {
+    std::string algorithm_header;
+    {
+        auto i_stream = inp.as_stream();
+
+        char c;
+        size_t sanity_size_check = 0;
+        bool err = false;
+        while (i_stream.get(c)) {
+            err = false;
+            if (sanity_size_check > 1023) {
+                err = true;
+                break;
+            } else if (c == '%') {
+                break;
+            } else {
+                algorithm_header.push_back(c);
+            }
+            sanity_size_check++;
+            err = true;
+        }
+
+        if (err) {
+            exit("Input did not have an algorithm header!");
+        }
+    }
+
+    // Slice off the header
+    inp = Input(inp, algorithm_header.size() + 1);
+    return algorithm_header;
+}
+
+/// Collects the input files of a batch, which is either a directory
+/// or a file listing one path per line.
+static std::vector<std::string> batch_files(const std::string& list) {
+    std::vector<std::string> files;
+
+    if (DIR* dir = opendir(list.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            auto path = list + "/" + entry->d_name;
+            if (file_exists(path)) files.push_back(path);
+        }
+        closedir(dir);
+        std::sort(files.begin(), files.end());
+    } else if (file_exists(list)) {
+        std::ifstream in(list);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty()) files.push_back(line);
+        }
+    } else {
+        exit("batch list not found: " + list);
+    }
+
+    return files;
+}
+
+/// Writes the recorded timeline to the file given with --trace.
+static void write_trace(const Options& options) {
+    if (options.trace.empty()) return;
+
+    std::ofstream trace_file;
+    trace_file.open(options.trace);
+    trace_file << Trace::to_json() << std::endl;
+    trace_file.close();
+}
+
+struct BatchResult {
+    std::string input;
+    std::string output;
+    std::string error;
+    size_t input_size = 0;
+    size_t output_size = 0;
+    double time = 0; // milliseconds
+    json stats;
+};
+
+/// Processes all files of a batch on a pool of worker threads.
+///
+/// Each worker selects its (de-)compressor once and reuses it for all of
+/// its files. Phase statistics are not thread-safe, hence they are only
+/// recorded per file when a single worker is used.
+static int run_batch(const Options& options) {
+    using clk = std::chrono::high_resolution_clock;
+
+    const auto& compressor_registry = Registry::of<Compressor>();
+    const auto& decompressor_registry = Registry::of<Decompressor>();
+
+    const bool do_compress = !options.decompress;
+    const std::vector<std::string> files = batch_files(options.batch);
+    const size_t num_workers = std::max(size_t(1),
+        std::min(options.threads, files.size()));
+    const bool track_phases = (num_workers == 1);
+
+    std::vector<BatchResult> results(files.size());
+    std::atomic<size_t> next_file { 0 };
+
+    auto worker = [&]() {
+        RegistryOf<Compressor>::Selection compressor;
+        RegistryOf<Decompressor>::Selection decompressor;
+        std::map<std::string, RegistryOf<Decompressor>::Selection> by_header;
+
+        if (do_compress) {
+            compressor = compressor_registry.select(options.algorithm);
+        } else if (!options.algorithm.empty()) {
+            decompressor = decompressor_registry.select(options.algorithm);
+        }
+
+        InputRestrictions restrictions(options.escape, options.sentinel);
+
+        for (size_t i = next_file++; i < files.size(); i = next_file++) {
+            auto& r = results[i];
+            r.input = files[i];
+
+            // determine output path
+            const std::string ending = "." + COMPRESSED_FILE_ENDING;
+            if (do_compress) {
+                r.output = r.input + ending;
+            } else if (r.input.size() > ending.size() &&
+                r.input.compare(r.input.size() - ending.size(),
+                    ending.size(), ending) == 0) {
+                r.output = r.input.substr(0, r.input.size() - ending.size());
+            } else {
+                r.output = r.input + ".out";
+            }
+
+            Trace::Scope trace(r.input);
+
+            const auto start_time = clk::now();
+            try {
+                if (!file_exists(r.input)) {
+                    exit("input path not found or is not a file");
+                }
+                if (file_exists(r.output) && !options.force) {
+                    exit("output file already exists: " + r.output);
+                }
+
+                std::unique_ptr<StatPhase> root;
+                if (track_phases) root = std::make_unique<StatPhase>("root");
+
+                {
+                    Input inp(io::Path{r.input});
+                    r.input_size = inp.size();
+                    Output out(io::Path(r.output), true);
+
+                    if (do_compress) {
+                        if (!options.raw) {
+                            auto o_stream = out.as_stream();
+                            o_stream << compressor->decompressor()->config().str()
+                                     << '%';
+                        }
+
+                        if(restrictions.has_restrictions()) {
+                            inp = Input(inp, restrictions);
+                        }
+                        compressor->compress(inp, out);
+                    } else {
+                        Decompressor* dec = decompressor ?
+                            &decompressor.instance() : nullptr;
+
+                        if (!options.raw) {
+                            auto header = read_header(inp);
+                            if (!dec) {
+                                auto& sel = by_header[header];
+                                if (!sel) {
+                                    sel = decompressor_registry.select(header);
+                                }
+                                dec = &sel.instance();
+                            }
+                        }
+
+                        if(restrictions.has_restrictions()) {
+                            out = Output(out, restrictions);
+                        }
+                        dec->decompress(inp, out);
+                    }
+                }
+
+                if (root) {
+                    r.stats = root->to_json();
+                    Trace::add_phases(r.stats);
+                }
+                r.output_size = io::read_file_size(r.output);
+            } catch (std::exception& e) {
+                r.error = e.what();
+            }
+            r.time = std::chrono::duration<double, std::milli>(
+                clk::now() - start_time).count();
+
+            trace.log("inputSize", r.input_size);
+            trace.log("outputSize", r.output_size);
+            if (!r.error.empty()) trace.log("error", r.error);
+        }
+    };
+
+    const auto start_time = clk::now();
+    if (track_phases) {
+        worker();
+    } else {
+        StatPhase::pause_tracking();
+
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < num_workers; t++) {
+            pool.emplace_back(worker);
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+
+        StatPhase::resume_tracking();
+    }
+    const auto end_time = clk::now();
+
+    // report
+    size_t failed = 0, in_total = 0, out_total = 0;
+    json report_files = json::array();
+    for (auto& r : results) {
+        if (!r.error.empty()) {
+            ++failed;
+            std::cerr << r.input << ": " << r.error << std::endl;
+        }
+
+        in_total += r.input_size;
+        out_total += r.output_size;
+
+        json f;
+        f["input"] = r.input;
+        f["inputSize"] = r.input_size;
+        f["output"] = r.output;
+        f["outputSize"] = r.output_size;
+        f["time"] = r.time;
+        if (!r.error.empty()) f["error"] = r.error;
+        if (!r.stats.is_null()) f["data"] = r.stats;
+        report_files.push_back(f);
+    }
+
+    if (options.stats) {
+        json meta;
+        meta["title"] = options.stats_title;
+        meta["startTime"] =
+            std::chrono::duration_cast<std::chrono::seconds>(
+                start_time.time_since_epoch()).count();
+        meta["config"] = do_compress ? options.algorithm : "<decompress>";
+        meta["batch"] = options.batch;
+        meta["threads"] = num_workers;
+        meta["files"] = files.size();
+        meta["failed"] = failed;
+        meta["inputSize"] = in_total;
+        meta["outputSize"] = out_total;
+        meta["rate"] = (in_total == 0) ? 0.0 :
+            double(out_total) / double(in_total);
+        meta["time"] = std::chrono::duration<double, std::milli>(
+            end_time - start_time).count();
+
+        json stats = {{"meta", meta}, {"files", report_files}};
+        if (options.stat_file == "") {
+            std::cout << stats << std::endl;
+        } else {
+            std::ofstream stat_file;
+            stat_file.open(options.stat_file);
+            stat_file << stats << std::endl;
+            stat_file.close();
+        }
+    }
+
+    write_trace(options);
+    return (failed > 0) ? 1 : 0;
+}
+
+/// Summarizes a series of measured times (in milliseconds) for the
+/// given amount of processed bytes. The throughput is given in MiB/s.
+static json bench_summary(std::vector<double> times, size_t bytes) {
+    std::sort(times.begin(), times.end());
+
+    // nearest-rank percentile
+    auto percentile = [&](double p) {
+        size_t rank = size_t(std::ceil(p * times.size()));
+        return times[std::max(rank, size_t(1)) - 1];
+    };
+
+    double sum = 0;
+    for (double t : times) sum += t;
+
+    const double median = percentile(0.5);
+
+    json latency;
+    latency["min"] = times.front();
+    latency["mean"] = sum / times.size();
+    latency["p50"] = median;
+    latency["p90"] = percentile(0.9);
+    latency["p99"] = percentile(0.99);
+    latency["max"] = times.back();
+
+    json r;
+    r["latency"] = latency;
+    r["throughput_mib_s"] = (median == 0) ? 0.0 :
+        (double(bytes) / (1024.0 * 1024.0)) / (median / 1000.0);
+    return r;
+}
+
+/// Runs warmup and measured round-trips of the selected compressor on an
+/// in-memory text and prints the timings as JSON.
+///
+/// Each round-trip is checked for equality with the input. Phase
+/// statistics are taken from the last measured round.
+static int run_bench(const Options& options,
+                     const std::vector<uint8_t>& text,
+                     const std::string& input_name) {
+    using clk = std::chrono::high_resolution_clock;
+    auto ms = [](clk::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    auto compressor = Registry::of<Compressor>().select(options.algorithm);
+    auto decompressor = compressor->decompressor();
+
+    InputRestrictions restrictions(options.escape, options.sentinel);
+
+    const size_t rounds = options.bench;
+    std::vector<double> comp_times, decomp_times;
+    json comp_stats, decomp_stats;
+    size_t comp_size = 0;
+
+    const auto start_time = clk::now();
+    for (size_t round = 0; round < 2 * rounds; round++) {
+        const bool measured = (round >= rounds);
+
+        std::vector<uint8_t> compressed;
+        {
+            StatPhase phase("compress");
+
+            Input inp(text);
+            if(restrictions.has_restrictions()) {
+                inp = Input(inp, restrictions);
+            }
+            Output out(compressed);
+
+            const auto t = clk::now();
+            compressor->compress(inp, out);
+            const auto d = clk::now() - t;
+
+            if (measured) {
+                comp_times.push_back(ms(d));
+                comp_stats = phase.to_json();
+                Trace::add_phases(comp_stats);
+            }
+        }
+        comp_size = compressed.size();
+
+        std::vector<uint8_t> decompressed;
+        {
+            StatPhase phase("decompress");
+
+            Input inp(compressed);
+            Output out(decompressed);
+            if(restrictions.has_restrictions()) {
+                out = Output(out, restrictions);
+            }
+
+            const auto t = clk::now();
+            decompressor->decompress(inp, out);
+            const auto d = clk::now() - t;
+
+            if (measured) {
+                decomp_times.push_back(ms(d));
+                decomp_stats = phase.to_json();
+                Trace::add_phases(decomp_stats);
+            }
+        }
+
+        if (decompressed != text) {
+            std::cerr << "Error: round-trip mismatch in round " << round
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    json meta;
+    meta["title"] = options.stats_title;
+    meta["startTime"] =
+        std::chrono::duration_cast<std::chrono::seconds>(
+            start_time.time_since_epoch()).count();
+    meta["config"] = compressor->config().str();
+    meta["input"] = input_name;
+    meta["inputSize"] = text.size();
+    meta["outputSize"] = comp_size;
+    meta["rate"] = text.empty() ? 0.0 :
+        double(comp_size) / double(text.size());
+    meta["rounds"] = rounds;
+    meta["peakRSS"] = size_t(usage.ru_maxrss) * 1024; // kilobytes on Linux
+
+    json compress = bench_summary(comp_times, text.size());
+    compress["data"] = comp_stats;
+    json decompress = bench_summary(decomp_times, text.size());
+    decompress["data"] = decomp_stats;
+
+    json stats = {
+        {"meta", meta},
+        {"compress", compress},
+        {"decompress", decompress}
+    };
+    if (options.stat_file == "") {
+        std::cout << stats << std::endl;
+    } else {
+        std::ofstream stat_file;
+        stat_file.open(options.stat_file);
+        stat_file << stats << std::endl;
+        stat_file.close();
+    }
+
+    write_trace(options);
+    return 0;
+}
+
 } // namespace tdc_driver
 
 #include <iomanip>
@@ -93,6 +521,27 @@ int main(int argc, char** argv) {
     // init logging
     google::InitGoogleLogging(cmd);
 
+    // record hardware performance counters in the phase statistics
+    if(options.perf) {
+#ifdef __linux__
+        if(PerfStatExtension::available()) {
+            StatPhase::register_extension<PerfStatExtension>();
+        } else {
+            std::cerr << cmd << ": performance counters are not available "
+                "(check /proc/sys/kernel/perf_event_paranoid)" << std::endl;
+        }
+#else
+        std::cerr << cmd << ": performance counters are only supported on Linux"
+            << std::endl;
+#endif
+    }
+
+    // record a timeline of phases and threads
+    if(!options.trace.empty()) {
+        Trace::enable();
+        StatPhase::register_extension<TraceStatExtension>();
+    }
+
     // register chain compressor syntax in ast parser
     meta::ast::Parser::register_preprocessor<ChainSyntaxPreprocessor>();
 
@@ -281,6 +730,25 @@ int main(int argc, char** argv) {
             }
         }
 
+        // batch mode
+        if(!options.batch.empty()) {
+            if(options.stdin || options.stdout || !options.generator.empty() ||
+               !options.output.empty() || !options.remaining.empty()) {
+                return bad_usage(cmd, "batch mode reads and writes files on its own");
+            }
+            if(options.prefix > 0 || options.extract) {
+                return bad_usage(cmd, "batch mode does not support --prefix or --extract");
+            }
+            if(!options.decompress && options.algorithm.empty()) {
+                return bad_usage(cmd, "missing compression algorithm.");
+            }
+            if(options.decompress && options.raw && options.algorithm.empty()) {
+                return bad_usage(cmd, "missing algorithm for raw decompression");
+            }
+
+            return run_batch(options);
+        }
+
         // check mode
         const bool do_compress = !options.decompress;
 
@@ -328,6 +796,38 @@ int main(int argc, char** argv) {
             }
         }
 
+        // benchmark mode
+        if(options.bench > 0) {
+            if(options.decompress) {
+                return bad_usage(cmd, "benchmarks always compress and decompress");
+            }
+
+            // read the whole input into memory once
+            std::vector<uint8_t> text;
+            {
+                std::string generated;
+                Input inp;
+                if(options.stdin) {
+                    inp = Input(std::cin);
+                } else if(generator) {
+                    generated = generator->generate();
+                    inp = Input(generated);
+                } else {
+                    inp = Input(io::Path{file});
+                }
+
+                if(options.prefix > 0) {
+                    inp = Input(inp, 0, options.prefix);
+                }
+
+                auto view = inp.as_view();
+                text.assign(view.begin(), view.end());
+            }
+
+            return run_bench(options, text, options.stdin ? "<stdin>" :
+                (generator ? options.generator : file));
+        }
+
         // determined later
         std::string generated;
         size_t in_size;
@@ -430,35 +930,8 @@ int main(int argc, char** argv) {
                 // --decompress --raw --algorithm : no header
 
                 std::string algorithm_header;
-                {
-                    auto i_stream = inp.as_stream();
-                    if (!options.raw)
-                    {
-                        // read header
-                        char c;
-                        size_t sanity_size_check = 0;
-                        bool err = false;
-                        while (i_stream.get(c)) {
-                            err = false;
-                            if (sanity_size_check > 1023) {
-                                err = true;
-                                break;
-                            } else if (c == '%') {
-                                break;
-                            } else {
-                                algorithm_header.push_back(c);
-                            }
-                            sanity_size_check++;
-                            err = true;
-                        }
-
-                        if (err) {
-                            exit("Input did not have an algorithm header!");
-                        }
-
-                        // Slice off the header
-                        inp = Input(inp, algorithm_header.size() + 1);
-                    }
+                if (!options.raw) {
+                    algorithm_header = read_header(inp);
                 }
 
                 if (!options.raw && decompressor) {
@@ -480,7 +953,12 @@ int main(int argc, char** argv) {
                 }
 
                 setup_time = clk::now();
-                decompressor->decompress(inp, out);
+                if(options.extract) {
+                    decompressor->extract(inp, out,
+                        options.extract_offset, options.extract_length);
+                } else {
+                    decompressor->decompress(inp, out);
+                }
                 comp_time = clk::now();
             } else {
                 setup_time = clk::now();
@@ -498,9 +976,14 @@ int main(int argc, char** argv) {
 
         end_time = clk::now();
 
-        if (options.stats) {
-            auto algo_stats = root.to_json();
+        json algo_stats;
+        if (options.stats || !options.trace.empty()) {
+            algo_stats = root.to_json();
+            Trace::add_phases(algo_stats);
+            write_trace(options);
+        }
 
+        if (options.stats) {
             auto setup_duration = setup_time - start_time;
             auto comp_duration = comp_time - setup_time;
             auto end_duration = end_time - comp_time;
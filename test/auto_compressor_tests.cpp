@@ -0,0 +1,98 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <tudocomp/Literal.hpp>
+#include <tudocomp/compressors/AutoCompressor.hpp>
+#include <tudocomp/compressors/LCPCompressor.hpp>
+#include <tudocomp/compressors/NoopCompressor.hpp>
+#include <tudocomp/compressors/lzss/BufferedBidirectionalCoder.hpp>
+#include <tudocomp/decompressors/LCPDecompressor.hpp>
+#include <tudocomp/decompressors/WrapDecompressor.hpp>
+
+#include "test/util.hpp"
+
+using namespace tdc;
+
+using lz78_t = LZ78Compressor<BinaryCoder, lz_trie::TernaryTrie>;
+using lzss_t = LZSSSlidingWindowCompressor<
+    lzss::StreamingCoder<BinaryCoder, BinaryCoder, BinaryCoder>>;
+using repair_t = RePairCompressor<BinaryCoder>;
+using lcpcomp_coder_t = lzss::BufferedBidirectionalCoder<
+    BinaryCoder, BinaryCoder, BinaryCoder>;
+using lcpcomp_t = LCPCompressor<lcpcomp_coder_t>;
+
+class AutoCompressorTest : public ::testing::Test {
+protected:
+    static void SetUpTestCase() {
+        auto& c = Registry::of<Compressor>();
+        c.register_algorithm<lz78_t>();
+        c.register_algorithm<lzss_t>();
+        c.register_algorithm<repair_t>();
+        c.register_algorithm<NoopCompressor>();
+        c.register_algorithm<lcpcomp_t>();
+
+        auto& d = Registry::of<Decompressor>();
+        d.register_algorithm<LZ78Decompressor<BinaryCoder>>();
+        d.register_algorithm<LZSSDecompressor<
+            lzss::StreamingCoder<BinaryCoder, BinaryCoder, BinaryCoder>>>();
+        d.register_algorithm<WrapDecompressor>();
+        d.register_algorithm<LCPDecompressor<lcpcomp_coder_t>>();
+    }
+
+    // the decompressor recorded in front of the compressed text
+    static std::string selected(const std::string& str, const std::string& options) {
+        auto result = test::compress<AutoCompressor>(str, options,
+            InputRestrictions::none(), Registry::of<Compressor>());
+        result.assert_decompress();
+        return result.str.substr(0, result.str.find('\0'));
+    }
+};
+
+TEST_F(AutoCompressorTest, roundtrip) {
+    test::roundtrip_batch([](const std::string& str) {
+        test::roundtrip_ex<AutoCompressor>(str, "", "block_size=4");
+    });
+    test::on_string_generators([](const std::string& str) {
+        test::roundtrip_ex<AutoCompressor>(str, "", "blocks=3, block_size=16");
+    }, 13);
+}
+
+TEST_F(AutoCompressorTest, objective) {
+    // highly repetitive, so all candidates compress better than noop
+    std::string str;
+    for(size_t i = 0; i < 2000; ++i) str += "abcdefgh";
+
+    ASSERT_EQ(0U, selected(str, "candidates=[noop, repair], objective='speed'").find("wrap(c=noop"));
+    ASSERT_EQ(0U, selected(str, "candidates=[noop, repair], objective='ratio'").find("wrap(c=repair"));
+    ASSERT_EQ(0U, selected(str, "candidates=[noop, repair]").find("wrap(c=repair"));
+
+    // a single candidate is used without trials
+    ASSERT_EQ(0U, selected(str, "candidates=[lz78]").find("lz78"));
+}
+
+TEST_F(AutoCompressorTest, sentinel) {
+    // lcpcomp requires a sentinel, which is appended to every sampled block
+    static const std::string candidates = "candidates=[noop, "
+        "lcpcomp(coder=bi(binary, binary, binary))], objective='ratio'";
+
+    std::string str;
+    for(size_t i = 0; i < 1000; ++i) str += "abcdefgh" + std::to_string(i % 7);
+    ASSERT_LT(size_t(4 * 256), str.size());
+
+    auto result = test::compress<AutoCompressor>(str, candidates + ", block_size=256",
+        InputRestrictions::none(), Registry::of<Compressor>());
+    result.assert_decompress();
+    ASSERT_EQ(0U, result.str.find("lcpcomp"));
+
+    // the sentinel is recorded after the decompressor
+    std::istringstream header(result.str.substr(result.str.find('\0') + 1));
+    InputRestrictions restrictions;
+    restrictions.deserialize(header);
+    ASSERT_TRUE(restrictions.null_terminate());
+
+    test::roundtrip_batch([](const std::string& str) {
+        test::roundtrip_ex<AutoCompressor>(str, "", candidates + ", block_size=4",
+            InputRestrictions::none(), Registry::of<Compressor>());
+    });
+}
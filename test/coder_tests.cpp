@@ -9,6 +9,7 @@
 #include <tudocomp/generators/ThueMorseGenerator.hpp>
 
 #include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/BinaryCoder.hpp>
 #include <tudocomp/coders/EliasDeltaCoder.hpp>
 #include <tudocomp/coders/EliasGammaCoder.hpp>
 #include <tudocomp/coders/HuffmanCoder.hpp>
@@ -198,6 +199,89 @@ void test_mixed(const std::string& options = "") {
     }
 }
 
+template<typename coder_t>
+void test_many(const std::string& options = "") {
+    // Generate a fibonacci word and use it as test subject
+    const std::string word = FibonacciGenerator::generate(20);
+
+    std::vector<uliteral_t> literals(word.begin(), word.end());
+    std::vector<bool> bits;
+    std::vector<size_t> ints, small_ints;
+    for(size_t i = 0; i < word.length(); i++) {
+        bits.push_back(word[i] == 'a');
+        ints.push_back((i * 7919) % 1000);
+        small_ints.push_back(1 + i % 13);
+    }
+
+    Range int_r(1000);
+    MinDistributedRange small_r(1, 13);
+
+    // Encode value by value and in batches, which must yield the same output
+    auto encode = [&](bool batched) {
+        std::stringstream ss;
+        {
+            Output out(ss);
+            typename coder_t::Encoder coder(
+                coder_t::meta().config(options), out, ViewLiterals(word));
+
+            if(batched) {
+                coder.encode_many(bits.begin(), bits.end(), bit_r);
+                coder.encode_many(ints.begin(), ints.end(), int_r);
+                coder.encode_many(small_ints.begin(), small_ints.end(), small_r);
+                coder.encode_many(literals.begin(), literals.end(), literal_r);
+                coder.encode_many(ints.begin(), ints.begin(), int_r); // empty
+            } else {
+                for(bool b : bits) coder.encode(b, bit_r);
+                for(size_t x : ints) coder.encode(x, int_r);
+                for(size_t x : small_ints) coder.encode(x, small_r);
+                for(uliteral_t c : literals) coder.encode(c, literal_r);
+            }
+        }
+        return ss.str();
+    };
+
+    const std::string result = encode(true);
+    ASSERT_EQ(encode(false), result);
+
+    // Decode in batches
+    {
+        Input in(result);
+        typename coder_t::Decoder decoder(
+            coder_t::meta().config(options), in);
+
+        std::vector<uint8_t> dec_bits(bits.size());
+        decoder.decode_many(dec_bits.begin(), dec_bits.end(), bit_r);
+        for(size_t i = 0; i < bits.size(); i++) {
+            ASSERT_EQ(bits[i], dec_bits[i] != 0) << "i=" << i;
+        }
+
+        std::vector<size_t> dec_ints(ints.size());
+        decoder.decode_many(dec_ints.begin(), dec_ints.end(), int_r);
+        ASSERT_EQ(ints, dec_ints);
+
+        std::vector<size_t> dec_small_ints(small_ints.size());
+        decoder.decode_many(dec_small_ints.begin(), dec_small_ints.end(), small_r);
+        ASSERT_EQ(small_ints, dec_small_ints);
+
+        std::vector<uliteral_t> dec_literals(literals.size());
+        decoder.decode_many(dec_literals.begin(), dec_literals.end(), literal_r);
+        ASSERT_EQ(literals, dec_literals);
+
+        ASSERT_TRUE(decoder.eof());
+    }
+}
+
+TEST(coder, binary_many) { test_many<BinaryCoder>(); }
+TEST(coder, ascii_many) { test_many<ASCIICoder>(); }
+TEST(coder, sle_kmer_many) { test_many<SLEKmerCoder>(); }
+TEST(coder, sle_int_many) { test_many<SLEIntCoder>(); }
+TEST(coder, delta_many) { test_many<EliasDeltaCoder>(); }
+TEST(coder, gamma_many) { test_many<EliasGammaCoder>(); }
+TEST(coder, sigma_many) { test_many<SigmaCoder>(); }
+TEST(coder, huff_many) { test_many<HuffmanCoder>(); }
+TEST(coder, arithm_many) { test_many<ArithmeticCoder>(); }
+TEST(coder, ternary_many) { test_many<TernaryCoder>(); }
+
 TEST(coder, ascii_mt) { test_mt<ASCIICoder>(); }
 TEST(coder, ascii_bits) { test_bits<ASCIICoder>(); }
 TEST(coder, ascii_int) { test_int<ASCIICoder>(); }
@@ -258,3 +342,4 @@ TEST(coder, rice_bits) { for(size_t i = 1; i < RICE; i++) test_bits<RiceCoder>(t
 TEST(coder, rice_int) { for(size_t i = 1; i < RICE; i++) test_int<RiceCoder>(to_string(i)); }
 TEST(coder, rice_str) { for(size_t i = 1; i < RICE; i++) test_str<RiceCoder>(to_string(i)); }
 TEST(coder, rice_mixed) { for(size_t i = 1; i < RICE; i++) test_mixed<RiceCoder>(to_string(i)); }
+TEST(coder, rice_many) { for(size_t i = 1; i < RICE; i++) test_many<RiceCoder>(to_string(i)); }
@@ -7,10 +7,13 @@
 
 #include <tudocomp/ds/providers/DivSufSort.hpp>
 #include <tudocomp/ds/providers/ISAFromSA.hpp>
+#include <tudocomp/ds/providers/BlockedISAFromSA.hpp>
+#include <tudocomp/ds/providers/BlockedPhiFromSA.hpp>
 #include <tudocomp/ds/providers/SparseISA.hpp>
 #include <tudocomp/ds/providers/PhiAlgorithm.hpp>
 #include <tudocomp/ds/providers/PhiFromSA.hpp>
 #include <tudocomp/ds/providers/LCPFromPLCP.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
 
 #include <memory>
 #include <tuple>
@@ -220,3 +223,118 @@ TEST(ds, retain_byproduct) {
     dsman.get<ds::SUFFIX_ARRAY>();
 }
 
+
+// concurrent construction
+using plain_dsmanager_t = DSManager<
+    DivSufSort, ISAFromSA, PhiFromSA, PhiAlgorithm, LCPFromPLCP>;
+
+TEST(ds, concurrent) {
+    // test input
+    std::string input;
+    for(size_t i = 0; i < 10000; i++) input.push_back('a' + (i * i) % 7);
+    input.push_back('\0');
+
+    for(auto cm : {"plain", "delayed", "compressed"}) {
+        const std::string cfg = std::string("compress=\"") + cm + "\"";
+
+        plain_dsmanager_t serial(
+            plain_dsmanager_t::meta().config(cfg), input);
+        plain_dsmanager_t concurrent(
+            plain_dsmanager_t::meta().config(cfg + ", threads=4"), input);
+
+        serial.construct<
+            ds::SUFFIX_ARRAY, ds::INVERSE_SUFFIX_ARRAY, ds::LCP_ARRAY>();
+        concurrent.construct<
+            ds::SUFFIX_ARRAY, ds::INVERSE_SUFFIX_ARRAY, ds::LCP_ARRAY>();
+
+        ASSERT_EQ(serial.get<ds::SUFFIX_ARRAY>(),
+                  concurrent.get<ds::SUFFIX_ARRAY>());
+        ASSERT_EQ(serial.get<ds::INVERSE_SUFFIX_ARRAY>(),
+                  concurrent.get<ds::INVERSE_SUFFIX_ARRAY>());
+        ASSERT_EQ(serial.get<ds::LCP_ARRAY>(),
+                  concurrent.get<ds::LCP_ARRAY>());
+
+        ASSERT_EQ(serial.is_compressed(ds::LCP_ARRAY),
+                  concurrent.is_compressed(ds::LCP_ARRAY));
+        ASSERT_EQ(serial.get<ds::LCP_ARRAY>().width(),
+                  concurrent.get<ds::LCP_ARRAY>().width());
+
+        // the intermediate data structures have been discarded
+        ASSERT_FALSE(concurrent.is_constructed(ds::PHI_ARRAY));
+        ASSERT_FALSE(concurrent.is_constructed(ds::PLCP_ARRAY));
+    }
+}
+
+TEST(ds, concurrent_retain) {
+    std::string input("banana\0", 7);
+    plain_dsmanager_t dsman(
+        plain_dsmanager_t::meta().config("threads=2"), input);
+
+    // Phi and PLCP are requested, so Phi must not be used in-place
+    dsman.construct<ds::PHI_ARRAY, ds::PLCP_ARRAY, ds::INVERSE_SUFFIX_ARRAY>();
+    ASSERT_FALSE(dsman.is_constructed(ds::SUFFIX_ARRAY));
+
+    auto& phi = dsman.get<ds::PHI_ARRAY>();
+    auto& plcp = dsman.get<ds::PLCP_ARRAY>();
+    auto& isa = dsman.get<ds::INVERSE_SUFFIX_ARRAY>();
+    ASSERT_EQ(7U, phi.size());
+    ASSERT_EQ(7U, isa.size());
+    ASSERT_EQ(std::vector<len_t>({0, 3, 2, 1, 0, 0, 0}),
+              std::vector<len_t>(plcp.begin(), plcp.end()));
+
+    // previously constructed data structures are retained
+    dsman.construct<ds::LCP_ARRAY>();
+    dsman.get<ds::PHI_ARRAY>();
+    dsman.get<ds::LCP_ARRAY>();
+}
+
+TEST(ds, concurrent_stats) {
+    std::string input;
+    for(size_t i = 0; i < 10000; i++) input.push_back('a' + (i * i) % 7);
+    input.push_back('\0');
+
+    plain_dsmanager_t serial(plain_dsmanager_t::meta().config(), input);
+    serial.construct<ds::INVERSE_SUFFIX_ARRAY, ds::LCP_ARRAY>();
+
+    // the providers track phases, so the batches must not
+    // touch the open phase concurrently
+    StatPhase root("root");
+
+    plain_dsmanager_t concurrent(
+        plain_dsmanager_t::meta().config("threads=4"), input);
+    concurrent.construct<ds::INVERSE_SUFFIX_ARRAY, ds::LCP_ARRAY>();
+
+    ASSERT_EQ(serial.get<ds::INVERSE_SUFFIX_ARRAY>(),
+              concurrent.get<ds::INVERSE_SUFFIX_ARRAY>());
+    ASSERT_EQ(serial.get<ds::LCP_ARRAY>(),
+              concurrent.get<ds::LCP_ARRAY>());
+
+    // the concurrent batch is tracked as a single phase
+    const std::string stats = root.to_json().dump();
+    ASSERT_NE(stats.find("\"threads\""), std::string::npos) << stats;
+}
+
+using blocked_dsmanager_t = DSManager<
+    DivSufSort, BlockedISAFromSA, BlockedPhiFromSA, PhiAlgorithm, LCPFromPLCP>;
+
+TEST(ds, concurrent_blocked) {
+    // large enough for the blocked scatter, the buffer of which
+    // counts towards the memory estimate of a batch
+    std::string input;
+    for(size_t i = 0; i < radix_scatter::MIN_SIZE; i++) {
+        input.push_back('a' + (i * i) % 7);
+    }
+    input.push_back('\0');
+
+    blocked_dsmanager_t serial(blocked_dsmanager_t::meta().config(), input);
+    blocked_dsmanager_t concurrent(
+        blocked_dsmanager_t::meta().config("threads=2"), input);
+
+    serial.construct<ds::INVERSE_SUFFIX_ARRAY, ds::PHI_ARRAY>();
+    concurrent.construct<ds::INVERSE_SUFFIX_ARRAY, ds::PHI_ARRAY>();
+
+    ASSERT_EQ(serial.get<ds::INVERSE_SUFFIX_ARRAY>(),
+              concurrent.get<ds::INVERSE_SUFFIX_ARRAY>());
+    ASSERT_EQ(serial.get<ds::PHI_ARRAY>(),
+              concurrent.get<ds::PHI_ARRAY>());
+}
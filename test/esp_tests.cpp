@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "test/util.hpp"
 
+#include <random>
+
 #include "tudocomp/compressors/EspCompressor.hpp"
 
 #include "tudocomp/compressors/esp/SLPDepSort.hpp"
@@ -13,6 +15,7 @@
 
 #include <tudocomp/compressors/esp/HashMapIPD.hpp>
 #include <tudocomp/compressors/esp/DynamicSizeIPD.hpp>
+#include <tudocomp/compressors/esp/PackedHashIPD.hpp>
 
 using namespace tdc;
 
@@ -436,7 +439,74 @@ TEST(Esp, tree_reducer_roundtrip) {
 
 }
 
-template<typename T>
+TEST(Esp, parallel_levels_equal_sequential) {
+    test::on_string_generators([&](const std::string& s) {
+        esp::EspContext<test_ipd_t> seq;
+        auto seq_slp = seq.generate_grammar(s.begin(), s.end(), s.size(), 256);
+
+        // split every level into 4 chunks of at least 8 symbols
+        esp::EspContext<test_ipd_t> par { 4, 8 };
+        auto par_slp = par.generate_grammar(s.begin(), s.end(), s.size(), 256);
+
+        ASSERT_EQ(par_slp.derive_text_s(), s);
+        ASSERT_EQ(par_slp.size(), seq_slp.size());
+        ASSERT_EQ(par_slp.root_rule(), seq_slp.root_rule());
+        for (size_t i = 0; i < seq_slp.size(); i++) {
+            ASSERT_EQ(par_slp.get_l(i), seq_slp.get_l(i)) << "rule " << i;
+            ASSERT_EQ(par_slp.get_r(i), seq_slp.get_r(i)) << "rule " << i;
+        }
+
+        ASSERT_EQ(par.ipd_stats.ext_size2_total, seq.ipd_stats.ext_size2_total);
+        ASSERT_EQ(par.ipd_stats.ext_size3_total, seq.ipd_stats.ext_size3_total);
+        ASSERT_EQ(par.ipd_stats.ext_size3_unique, seq.ipd_stats.ext_size3_unique);
+        ASSERT_EQ(par.ipd_stats.int_size2_total, seq.ipd_stats.int_size2_total);
+        ASSERT_EQ(par.ipd_stats.int_size2_unique, seq.ipd_stats.int_size2_unique);
+    }, 16);
+}
+
+TEST(Esp, parallel_levels_equal_sequential_many_chunks) {
+    // a random text over a small alphabet has runs everywhere, so the
+    // lower levels get split into 8 chunks of at least 64 symbols each
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist('a', 'd');
+    std::string s(1 << 14, 0);
+    for (auto& c : s) c = char(dist(gen));
+
+    esp::EspContext<test_ipd_t> seq;
+    auto seq_slp = seq.generate_grammar(s.begin(), s.end(), s.size(), 256);
+
+    esp::EspContext<test_ipd_t> par { 8, 64 };
+    auto par_slp = par.generate_grammar(s.begin(), s.end(), s.size(), 256);
+
+    ASSERT_EQ(par_slp.derive_text_s(), s);
+    ASSERT_EQ(par_slp.size(), seq_slp.size());
+    ASSERT_EQ(par_slp.root_rule(), seq_slp.root_rule());
+    for (size_t i = 0; i < seq_slp.size(); i++) {
+        ASSERT_EQ(par_slp.get_l(i), seq_slp.get_l(i)) << "rule " << i;
+        ASSERT_EQ(par_slp.get_r(i), seq_slp.get_r(i)) << "rule " << i;
+    }
+}
+
+TEST(Esp, extract_range) {
+    test::on_string_generators([&](const std::string& s) {
+        esp::EspContext<test_ipd_t> context;
+        auto slp = context.generate_grammar(s.begin(), s.end(), s.size(), 256);
+        slp.compute_lengths();
+        ASSERT_EQ(slp.text_length(), s.size());
+
+        const size_t step = std::max<size_t>(1, s.size() / 7);
+        for (size_t offset = 0; offset <= s.size() + 1; offset += step) {
+            for (size_t length : { size_t(0), size_t(1), size_t(5), step, s.size() }) {
+                std::stringstream ss;
+                slp.extract_text(ss, offset, length);
+                ASSERT_EQ(ss.str(), offset < s.size() ? s.substr(offset, length) : "")
+                    << "offset " << offset << ", length " << length;
+            }
+        }
+    }, 16);
+}
+
+template<typename T, typename ipd_t = esp::StdUnorderedMapIPD>
 void test_esp() {
  // TODO: ensure ESP code is parametric over input alphabet size and format
 
@@ -470,7 +540,7 @@ void test_esp() {
 
     for (auto& c : cases) {
         std::cout << "---------------------\n";
-        test::roundtrip<EspCompressor<T>>(c);
+        test::roundtrip<EspCompressor<T, ipd_t>>(c);
     }
 }
 
@@ -502,6 +572,69 @@ TEST(ESP, test_sorted_range_fit) {
    test_esp<esp::SortedSLPCoder<esp::DRangeFit>>();
 }
 
+TEST(Esp, packed_hash_ipd_ids) {
+    using map_t = esp::PackedHashIPD::IPDMap<2, size_t, size_t>;
+    map_t map(0, esp::Array<2>());
+
+    size_t counter = 257;
+    auto updater = [&](size_t& v) {
+        if (v == 0) {
+            v = counter++;
+        }
+    };
+    auto key = [](size_t a, size_t b) {
+        esp::Array<2> k;
+        k.m_data[0] = a;
+        k.m_data[1] = b;
+        return k;
+    };
+
+    // enough keys to grow the table several times, with growing widths
+    std::vector<std::array<size_t, 2>> keys;
+    for (size_t i = 0; i < 1000; i++) {
+        keys.push_back({{ (i * 7919) % 1000, i * i }});
+    }
+    keys.push_back({{ 1, 0 }});
+    keys.push_back({{ size_t(1) << 30, 1 }});
+
+    // pairs near the largest supported id
+    const size_t max_id = (size_t(1) << 32) - 1;
+    keys.push_back({{ max_id, max_id }});
+    keys.push_back({{ max_id, 0 }});
+    keys.push_back({{ 0, max_id }});
+    keys.push_back({{ max_id - 1, max_id }});
+    keys.push_back({{ max_id, max_id - 1 }});
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        ASSERT_EQ(map.access(key(keys[i][0], keys[i][1]), updater), 257 + i);
+    }
+    ASSERT_EQ(map.size(), keys.size());
+
+    // existing keys keep their ids
+    for (size_t i = keys.size(); i > 0; i--) {
+        const auto& k = keys[i - 1];
+        ASSERT_EQ(map.access(key(k[0], k[1]), updater), 257 + i - 1);
+    }
+    ASSERT_EQ(counter, 257 + keys.size());
+
+    ASSERT_THROW(map.access(key(max_id + 1, 0), updater), std::overflow_error);
+
+    // enumeration is in insertion order
+    size_t i = 0;
+    map.for_all([&](const esp::Array<2>& k, size_t v) {
+        ASSERT_LT(i, keys.size());
+        ASSERT_EQ(k.m_data[0], keys[i][0]) << "entry " << i;
+        ASSERT_EQ(k.m_data[1], keys[i][1]) << "entry " << i;
+        ASSERT_EQ(v, 257 + i);
+        i++;
+    });
+    ASSERT_EQ(i, keys.size());
+}
+
+TEST(ESP, test_packed_hash_ipd) {
+   test_esp<esp::PlainSLPCoder, esp::PackedHashIPD>();
+}
+
 /*TEST(ESP, test_optimal_arithmetic) {
    test_esp<esp::SortedSLPCoder<esp::DArithmetic>>();
 }*/
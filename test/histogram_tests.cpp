@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include <tudocomp/Literal.hpp>
+#include <tudocomp/io.hpp>
+#include <tudocomp/util/Histogram.hpp>
+#include <tudocomp/coders/SLEKmerCoder.hpp>
+#include <tudocomp/coders/HuffmanCoder.hpp>
+
+using namespace tdc;
+
+/// Hides the view of the literals, so they are counted one by one.
+class IteratedLiterals : LiteralIterator {
+    ViewLiterals m_literals;
+
+public:
+    inline IteratedLiterals(View view) : m_literals(view) {
+    }
+
+    inline bool has_next() const { return m_literals.has_next(); }
+    inline Literal next() { return m_literals.next(); }
+};
+
+static std::string random_text(size_t n, size_t sigma, size_t seed) {
+    std::mt19937_64 rng(seed);
+    std::string text(n, 0);
+    for(auto& c : text) c = char('a' + rng() % sigma);
+    return text;
+}
+
+TEST(histogram, count_bytes) {
+    for(size_t n : {0, 1, 7, 8, 9, 1000, 3 * (1 << 20) + 5}) {
+        const std::string text = random_text(n, 26, n);
+
+        std::vector<size_t> expected(256, 0);
+        for(uint8_t c : text) ++expected[c];
+
+        // skip the first byte to count from an unaligned address
+        std::vector<size_t> counts(256, 0);
+        if(n > 0) {
+            ++counts[uint8_t(text[0])];
+            count_bytes((const uint8_t*) text.data() + 1, n - 1, counts.data());
+        }
+        ASSERT_EQ(expected, counts) << "n=" << n;
+    }
+}
+
+TEST(histogram, count_literals) {
+    const std::string text = random_text(100000, 7, 1);
+
+    std::vector<size_t> expected(256, 0);
+    for(uint8_t c : text) ++expected[c];
+
+    // view-backed literals only count the remaining literals
+    ViewLiterals view_literals(text);
+    std::vector<size_t> counts(256, 0);
+    ++counts[view_literals.next().c];
+    ASSERT_EQ(text.size() - 1, count_literals(view_literals, counts.data()));
+    ASSERT_EQ(expected, counts);
+    ASSERT_FALSE(view_literals.has_next());
+
+    IteratedLiterals literals(text);
+    std::vector<len_compact_t> compact_counts(256, 0);
+    ASSERT_EQ(text.size(), count_literals(literals, compact_counts.data()));
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), compact_counts.begin()));
+    ASSERT_FALSE(literals.has_next());
+}
+
+TEST(histogram, int_histogram) {
+    for(size_t bits : {8, 16, 40}) {
+        std::mt19937_64 rng(bits);
+        IntHistogram histogram(bits);
+        std::map<uint64_t, size_t> expected;
+
+        for(size_t i = 0; i < 200000; i++) {
+            const uint64_t key = (rng() % 5000) * (bits > 16 ? 7919 : 1) % (1ULL << bits);
+            histogram.increase(key);
+            ++expected[key];
+        }
+
+        std::map<uint64_t, size_t> counts;
+        histogram.for_each([&](uint64_t key, size_t n){ counts[key] = n; });
+        ASSERT_EQ(expected, counts) << "bits=" << bits;
+        ASSERT_EQ(expected.size(), histogram.size());
+    }
+}
+
+template<typename coder_t>
+void test_same_output(const std::string& text, const std::string& options = "") {
+    auto encode = [&](auto&& literals) {
+        std::stringstream ss;
+        {
+            Output out(ss);
+            typename coder_t::Encoder coder(
+                coder_t::meta().config(options), out, literals);
+            for(uint8_t c : text) coder.encode(c, literal_r);
+        }
+        return ss.str();
+    };
+
+    ASSERT_EQ(encode(IteratedLiterals(text)), encode(ViewLiterals(text)));
+}
+
+TEST(histogram, view_and_iterated_literals) {
+    const std::string text = random_text(50000, 4, 2) + "abracadabra";
+    test_same_output<HuffmanCoder>(text);
+    test_same_output<SLEKmerCoder>(text);
+    test_same_output<SLEKmerCoder>(text, "k=2");
+    test_same_output<SLEKmerCoder>(text, "k=5");
+}
@@ -511,6 +511,57 @@ struct DriverSplitSize {
     }
 };
 
+// Inputs longer than the blocks scanned at once by the escaping,
+// with escapeable bytes both clustered and spread out.
+struct LongEscape {
+    static std::string long_input() {
+        std::string s;
+        for (size_t i = 0; i < 10000; i++) {
+            if (i % 97 == 0 || (i > 5000 && i < 5040)) {
+                s.push_back(char(0));
+            } else if (i % 131 == 0) {
+                s.push_back(char(0xff));
+            } else if (i % 61 == 0) {
+                s.push_back(char(0xfe));
+            } else {
+                s.push_back('a' + (i * 7) % 26);
+            }
+        }
+        return s;
+    }
+
+    static std::string escape(const std::string& s, const InputRestrictions& r) {
+        FastEscapeMap map { EscapeMap(r) };
+        std::string e;
+        for (uint8_t c : s) {
+            if (map.lookup_flag_bool(c)) e.push_back(char(map.escape_byte()));
+            e.push_back(char(map.lookup_byte(c)));
+        }
+        if (r.null_terminate()) e.push_back(char(0));
+        return e;
+    }
+
+    template<typename InpSrc>
+    static void doit() {
+        const std::string in_str = long_input();
+        for (auto r : {
+            InputRestrictions { { 0 }, true },
+            InputRestrictions { { 0, 0xff }, false },
+            InputRestrictions { { 0, 0xff }, true },
+            InputRestrictions { { }, true },
+        }) {
+            const std::string escaped_str = escape(in_str, r);
+
+            InpSrc x { View(in_str) };
+            Input i = x.input();
+            i = Input(i, r);
+
+            ASSERT_EQ(i.size(), escaped_str.size());
+            input_equal(i, View(escaped_str));
+        }
+    }
+};
+
 template<typename InpSrc, typename Splitting>
 void i_matrix_test() {
     Splitting::template doit<InpSrc>();
@@ -554,6 +605,16 @@ TEST(InputMatrix, StreamSrc_DriverSplitSize) {
     i_matrix_test<StreamSrc, DriverSplitSize>();
 }
 
+TEST(InputMatrix, ViewSrc_LongEscape) {
+    i_matrix_test<ViewSrc, LongEscape>();
+}
+TEST(InputMatrix, FileSrc_LongEscape) {
+    i_matrix_test<FileSrc, LongEscape>();
+}
+TEST(InputMatrix, StreamSrc_LongEscape) {
+    i_matrix_test<StreamSrc, LongEscape>();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -711,6 +772,37 @@ TEST(OnputMatrix, StreamTrgt_OutDriverSplit) {
     o_matrix_test<StreamTrgt, OutDriverSplit>();
 }
 
+TEST(Output, file_async_large) {
+    // larger than the initial and the default double buffers
+    std::string expected;
+    for (size_t i = 0; i < (size_t(9) << 20); i++) {
+        expected.push_back('a' + (i * 7) % 26);
+    }
+
+    const std::string name = "io_test_async_out.txt";
+    const std::string path = test::test_file_path(name);
+    {
+        Output out(Path { path }, true);
+        auto os = out.as_stream();
+
+        // mix character-wise output, bulk writes and raw appends
+        size_t i = 0;
+        for (; i < 100000; i++) os.put(expected[i]);
+        os.write(expected.data() + i, 3 << 20);
+        i += 3 << 20;
+        ASSERT_EQ(size_t(os.tellp()), i);
+        os.append((const uint8_t*) expected.data() + i, expected.size() - i);
+    }
+    ASSERT_EQ(test::read_test_file(name), expected);
+
+    {
+        // further streams append
+        Output out(Path { path });
+        out.as_stream() << "xyz";
+    }
+    ASSERT_EQ(test::read_test_file(name), expected + "xyz");
+}
+
 const std::string ALPHABET("abcdefghijklmnopqrstuvwxyz");
 
 TEST(PrefixStreamBuffer, get) {
@@ -0,0 +1,105 @@
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorBulk.hpp>
+
+using namespace tdc;
+
+static DynamicIntVector random_vector(size_t n, uint8_t w, std::mt19937_64& gen) {
+    DynamicIntVector v(n, 0, w);
+    const uint64_t mask = bulk::width_mask(w);
+    for(size_t i = 0; i < n; i++) v[i] = gen() & mask;
+    return v;
+}
+
+TEST(int_vector_bulk, unpack) {
+    std::mt19937_64 gen(42);
+    for(size_t w = 1; w <= 64; w++) {
+        const DynamicIntVector v = random_vector(1000, w, gen);
+
+        // ranges of different alignments and lengths
+        for(size_t begin : { 0, 1, 3, 63, 64, 65, 500 }) {
+            for(size_t count : { 0, 1, 3, 4, 5, 64, 100, 435 }) {
+                std::vector<uint64_t> out(count);
+                bulk::unpack(v, begin, count, out.data());
+                for(size_t i = 0; i < count; i++) {
+                    ASSERT_EQ(uint64_t(v[begin + i]), out[i])
+                        << "w=" << w << ", begin=" << begin << ", i=" << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(int_vector_bulk, pack) {
+    std::mt19937_64 gen(7);
+    for(size_t w = 1; w <= 64; w++) {
+        for(size_t begin : { 0, 1, 3, 63, 64, 65, 500 }) {
+            for(size_t count : { 0, 1, 3, 64, 100, 435 }) {
+                DynamicIntVector v = random_vector(1000, w, gen);
+                const DynamicIntVector orig = v;
+
+                std::vector<uint64_t> in(count);
+                for(auto& x : in) x = gen(); // truncated to w bits
+                bulk::pack(v, begin, count, in.data());
+
+                const uint64_t mask = bulk::width_mask(w);
+                for(size_t i = 0; i < v.size(); i++) {
+                    if(i >= begin && i < begin + count) {
+                        ASSERT_EQ(in[i - begin] & mask, uint64_t(v[i]));
+                    } else {
+                        // elements outside of the range are untouched
+                        ASSERT_EQ(uint64_t(orig[i]), uint64_t(v[i]))
+                            << "w=" << w << ", begin=" << begin << ", i=" << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(int_vector_bulk, reader_writer) {
+    std::mt19937_64 gen(3);
+    for(size_t w : { 1, 7, 13, 32, 33, 64 }) {
+        for(size_t n : { 0, 1, 63, 64, 65, 1000 }) {
+            const DynamicIntVector v = random_vector(n, w, gen);
+
+            // copy using a reader and a writer
+            DynamicIntVector copy(n, 0, w);
+            {
+                bulk::Writer writer(copy);
+                for(uint64_t x : bulk::Reader(v)) writer.push_back(x);
+            }
+            ASSERT_EQ(v, copy);
+
+            // read from an offset
+            if(n > 10) {
+                bulk::Reader reader(v, 10);
+                for(size_t i = 10; i < n; i++) {
+                    ASSERT_TRUE(reader.has_next());
+                    ASSERT_EQ(uint64_t(v[i]), reader.next());
+                }
+                ASSERT_FALSE(reader.has_next());
+            }
+        }
+    }
+}
+
+TEST(int_vector_bulk, inplace) {
+    // a writer may trail a reader on the same vector
+    std::mt19937_64 gen(11);
+    DynamicIntVector v = random_vector(1000, 21, gen);
+    const DynamicIntVector orig = v;
+    {
+        bulk::Reader reader(v);
+        bulk::Writer writer(v);
+        while(reader.has_next()) writer.push_back(reader.next() + 1);
+    }
+    for(size_t i = 0; i < v.size(); i++) {
+        ASSERT_EQ((uint64_t(orig[i]) + 1) & bulk::width_mask(21), uint64_t(v[i]));
+    }
+}
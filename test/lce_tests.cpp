@@ -0,0 +1,79 @@
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include <tudocomp/ds/LCE.hpp>
+#include <tudocomp/generators/FibonacciGenerator.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+#include <tudocomp/generators/RunRichGenerator.hpp>
+
+using namespace tdc;
+
+// naive, but certainly correct LCE computation
+static size_t naive_lce(const std::string& t, size_t i, size_t j, size_t max) {
+    size_t l = 0;
+    while(l < max && t[i + l] == t[j + l]) ++l;
+    return l;
+}
+
+TEST(lce, direct) {
+    const std::string a = "xxabcdefghijklmnopqrstuvwxyz0123";
+    const std::string b = "yyabcdefghijklmnopqrstuvwxyz0124";
+    auto pa = (const uliteral_t*) a.data();
+    auto pb = (const uliteral_t*) b.data();
+
+    ASSERT_EQ(0U, lce::forward(pa, pb, a.size()));
+    ASSERT_EQ(a.size() - 3, lce::forward(pa + 2, pb + 2, a.size() - 2));
+    ASSERT_EQ(5U, lce::forward(pa + 2, pb + 2, 5));
+    ASSERT_EQ(a.size() - 3, lce::backward(pa + a.size() - 1, pb + b.size() - 1, a.size() - 1));
+    ASSERT_EQ(0U, lce::backward(pa + a.size(), pb + b.size(), a.size()));
+}
+
+TEST(lce, direct_mismatch_positions) {
+    // mismatches at every position of strings long enough for all
+    // comparison widths
+    const size_t n = 200;
+    const std::string a(n, 'a');
+    for(size_t k = 0; k < n; ++k) {
+        std::string b = a;
+        b[k] = 'b';
+        auto pa = (const uliteral_t*) a.data();
+        auto pb = (const uliteral_t*) b.data();
+
+        ASSERT_EQ(k, lce::forward(pa, pb, n));
+        ASSERT_EQ(std::min(k, size_t(100)), lce::forward(pa, pb, 100));
+        ASSERT_EQ(n - k - 1, lce::backward(pa + n, pb + n, n));
+    }
+}
+
+TEST(lce, texts) {
+    const std::vector<std::string> texts {
+        "",
+        "a",
+        std::string(5000, 'a'),
+        RandomUniformGenerator::generate(5000, 1, 'a', 'b'),
+        RandomUniformGenerator::generate(5000, 2, 'a', 'z'),
+        FibonacciGenerator::generate(20),
+        RunRichGenerator::generate(10),
+    };
+
+    for(auto& t : texts) {
+        auto p = (const uliteral_t*) t.data();
+        std::mt19937_64 gen(t.size());
+        for(size_t q = 0; q < 1000 && t.size() > 0; ++q) {
+            const size_t i = gen() % t.size();
+            const size_t j = gen() % t.size();
+            const size_t max = t.size() - std::max(i, j);
+            ASSERT_EQ(naive_lce(t, i, j, max), lce::forward(p + i, p + j, max))
+                << "i=" << i << ", j=" << j;
+
+            // the common suffix of the prefixes ending at i + max and j + max
+            size_t l = 0;
+            while(l < max && t[i + max - l - 1] == t[j + max - l - 1]) ++l;
+            ASSERT_EQ(l, lce::backward(p + i + max, p + j + max, max))
+                << "i=" << i << ", j=" << j;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <tudocomp/Compressor.hpp>
+#include <tudocomp/compressors/LongCommonStringCompressor.hpp>
+#include <tudocomp/compressors/long_common/AnchorTable.hpp>
+
+#include "test/util.hpp"
+
+using namespace tdc;
+
+using lcs_t = LongCommonStringCompressor<EscapingSparseFactorCoder>;
+
+template<size_t b>
+void test_block_roundtrip(const std::string& str) {
+    test::roundtrip_ex<lcs_t>(str, "", "b=" + std::to_string(b));
+}
+
+template<size_t b, size_t sample>
+void test_anchor_roundtrip(const std::string& str) {
+    test::roundtrip_ex<lcs_t>(str, "",
+        "mode='anchor',b=" + std::to_string(b) +
+        ",sample=" + std::to_string(sample) + ",table=1");
+}
+
+TEST(long_common_string, block_roundtrip) {
+    test::roundtrip_batch(test_block_roundtrip<4>);
+    test::on_string_generators(test_block_roundtrip<4>, 13);
+}
+
+TEST(long_common_string, anchor_roundtrip) {
+    test::roundtrip_batch(test_anchor_roundtrip<4, 1>);
+    test::roundtrip_batch(test_anchor_roundtrip<2, 4>);
+    test::on_string_generators(test_anchor_roundtrip<4, 1>, 13);
+    test::on_string_generators(test_anchor_roundtrip<8, 4>, 13);
+}
+
+TEST(long_common_string, unknown_mode) {
+    ASSERT_THROW(test::compress<lcs_t>("abcabcabc", "mode='blocks'"),
+                 std::invalid_argument);
+}
+
+TEST(long_common_string, anchor_near_duplicates) {
+    // copies of a random block with sparse edits
+    std::string block;
+    uint64_t x = 1;
+    for(size_t i = 0; i < 4096; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        block.push_back(char('a' + (x >> 59)));
+    }
+
+    std::string str;
+    for(size_t copy = 0; copy < 64; ++copy) {
+        std::string edited = block;
+        edited[(copy * 997) % block.size()] = '#';
+        str += edited;
+    }
+
+    auto result = test::compress<lcs_t>(str, "mode='anchor',b=32,sample=16");
+    result.assert_decompress();
+    ASSERT_LT(result.bytes.size(), 2 * block.size());
+}
+
+TEST(long_common_string, long_extensions) {
+    // repeats far longer than a window, extended exactly in both modes
+    std::string block;
+    uint64_t x = 7;
+    for(size_t i = 0; i < 5000; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        block.push_back(char('a' + (x >> 60)));
+    }
+    const std::string str = block + "#" + block + "$" + block.substr(1);
+
+    test::roundtrip_ex<lcs_t>(str, "", "b=20");
+    test::roundtrip_ex<lcs_t>(str, "", "mode='anchor',b=20,sample=8");
+}
+
+TEST(long_common_string, anchor_table) {
+    // a single bucket keeps the newest entries
+    const size_t ways = long_common::AnchorTable::WAYS;
+    long_common::AnchorTable table(0);
+    for(size_t end = 1; end <= 2 * ways; ++end) {
+        table.insert(end, end);
+    }
+
+    std::vector<size_t> found;
+    for(size_t end = 1; end <= 2 * ways; ++end) {
+        table.find(end, [&](size_t e){ found.push_back(e); });
+    }
+    ASSERT_EQ(ways, found.size());
+    ASSERT_EQ(ways + 1, found.front());
+
+    // the same fingerprint replaces its entry
+    table.insert(found.back(), 100);
+    size_t count = 0;
+    table.find(found.back(), [&](size_t e){ ASSERT_EQ(100U, e); ++count; });
+    ASSERT_EQ(1U, count);
+}
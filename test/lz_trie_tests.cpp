@@ -443,6 +443,41 @@ TEST(Trie, CompactHashTrieSplitKeyValue) {
     trie_test<CompactHashTrie<ch::SplitKeyValue<ch::Sparse>>>();
 }
 
+#include <tudocomp/Literal.hpp>
+#include <tudocomp/compressors/lz_trie/AutoTrie.hpp>
+#include <tudocomp/compressors/LZ78Compressor.hpp>
+#include <tudocomp/compressors/LZWCompressor.hpp>
+#include <tudocomp/coders/BinaryCoder.hpp>
+
+using auto_trie_t = AutoTrie<TernaryTrie, BinarySortedTrie, HashTrie<>>;
+
+template<typename compressor_t>
+void auto_trie_roundtrip(const std::string& str) {
+    test::roundtrip_ex<compressor_t>(str, "", "lz_trie=auto(sample=64)");
+}
+
+TEST(AutoTrie, roundtrip) {
+    using lz78_t = LZ78Compressor<BinaryCoder, auto_trie_t>;
+    using lzw_t = LZWCompressor<BinaryCoder, auto_trie_t>;
+
+    test::roundtrip_batch(auto_trie_roundtrip<lz78_t>);
+    test::on_string_generators(auto_trie_roundtrip<lz78_t>, 13);
+    test::roundtrip_batch(auto_trie_roundtrip<lzw_t>);
+    test::on_string_generators(auto_trie_roundtrip<lzw_t>, 13);
+}
+
+TEST(AutoTrie, same_output) {
+    // the selection must not change the factorization
+    const std::string str = "abcabcabcabcabcbacbacbcbabcabcacbabcbacbabcbcbabcbab";
+    for(auto options : { "lz_trie=auto(sample=0)", "lz_trie=auto(sample=16)",
+                         "lz_trie=auto(sample=1000)",
+                         "lz_trie=auto(load_factors=[])" }) {
+        auto selected = test::compress<LZ78Compressor<BinaryCoder, auto_trie_t>>(str, options);
+        auto fixed = test::compress<LZ78Compressor<BinaryCoder, TernaryTrie>>(str);
+        ASSERT_EQ(fixed.bytes, selected.bytes) << options;
+    }
+}
+
 // #include <tudocomp/compressors/lz_trie/MBonsaiTrie.hpp>
 // TEST(TrieStructure, MBonsaiGammaTrie) {
 //     trie_test<MBonsaiGammaTrie>(false);
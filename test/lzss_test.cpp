@@ -5,12 +5,28 @@
 
 #include <tudocomp/compressors/lzss/LZSSCoding.hpp>
 #include <tudocomp/compressors/lzss/DecompBackBuffer.hpp>
+#include <tudocomp/compressors/lzss/DecompStreamBuffer.hpp>
 #include <tudocomp/compressors/lzss/FactorBuffer.hpp>
 #include <tudocomp/compressors/lzss/UnreplacedLiterals.hpp>
 
 #include <tudocomp/compressors/lcpcomp/decompress/CompactDec.hpp>
 #include <tudocomp/compressors/lcpcomp/decompress/DecodeQueueListBuffer.hpp>
 #include <tudocomp/compressors/lcpcomp/decompress/MultiMapBuffer.hpp>
+#include <tudocomp/compressors/lcpcomp/decompress/PointerJumpIntEM.hpp>
+
+#include <tudocomp/compressors/LCPCompressor.hpp>
+#include <tudocomp/compressors/LZ77AproxCompressor.hpp>
+#include <tudocomp/compressors/LZSSLCPCompressor.hpp>
+#include <tudocomp/compressors/LZSSSlidingWindowCompressor.hpp>
+#include <tudocomp/compressors/lzss/BufferedBidirectionalCoder.hpp>
+#include <tudocomp/compressors/lzss/BufferedLeftCoder.hpp>
+#include <tudocomp/compressors/lzss/DidacticalCoder.hpp>
+#include <tudocomp/compressors/lzss/StreamingCoder.hpp>
+#include <tudocomp/coders/BinaryCoder.hpp>
+
+#include <tudocomp/ds/providers/SAIS.hpp>
+
+#include "test/util.hpp"
 
 using namespace tdc;
 
@@ -156,6 +172,54 @@ TEST(lzss, decode_back_buffer) {
     ASSERT_EQ("bananabanana", ss.str());
 }
 
+TEST(lzss, decode_stream_buffer) {
+    std::stringstream ss;
+
+    lzss::DecompStreamBuffer buffer(ss);
+    buffer.initialize(0);
+    lzss::initialize_window(buffer, 0); // unbounded
+    buffer.decode_literal('b');
+    buffer.decode_literal('a');
+    buffer.decode_literal('n');
+    buffer.decode_factor(1, 3);
+    buffer.decode_factor(0, 6);
+    buffer.process();
+
+    ASSERT_EQ("bananabanana", ss.str());
+}
+
+TEST(lzss, decode_stream_buffer_window) {
+    // a text much longer than the ring buffer, with references of
+    // exactly the maximum distance
+    const size_t max_ref = 100;
+    const size_t n = 1000000;
+
+    std::string text;
+    std::stringstream ss;
+
+    lzss::DecompStreamBuffer buffer(ss);
+    lzss::initialize_window(buffer, max_ref);
+    for(size_t i = 0; i < max_ref; i++) {
+        buffer.decode_literal('a' + i % 26);
+        text.push_back('a' + i % 26);
+    }
+    while(text.size() < n) {
+        const size_t len = std::min<size_t>(1 + text.size() % 250, n - text.size());
+        buffer.decode_factor(text.size() - max_ref, len);
+        for(size_t i = 0; i < len; i++) {
+            text.push_back(text[text.size() - max_ref]);
+        }
+
+        buffer.decode_literal('!');
+        text.push_back('!');
+    }
+    buffer.process();
+
+    ASSERT_EQ(text.size(), buffer.size());
+    ASSERT_LT(buffer.buffer_size(), n);
+    ASSERT_EQ(text, ss.str());
+}
+
 template<typename T>
 void test_forward_decode_buffer_chain() {
     auto buffer = Algorithm::instance<T>();
@@ -213,3 +277,109 @@ TEST(lzss, decode_forward_ql_buffer_chain) {
 TEST(lzss, decode_forward_ql_buffer_multiref) {
     test_forward_decode_buffer_multiref<lcpcomp::DecodeForwardQueueListBuffer>();
 }
+
+template<size_t window, size_t threshold>
+void test_lz77aprox_roundtrip(const std::string& str) {
+    test::roundtrip_ex<LZ77AproxCompressor<
+        lzss::StreamingCoder<BinaryCoder, BinaryCoder, BinaryCoder>>>(str, "",
+        "window=" + std::to_string(window) + ",threshold=" + std::to_string(threshold));
+}
+
+TEST(lzss, lz77aprox_roundtrip) {
+    test::roundtrip_batch(test_lz77aprox_roundtrip<16, 2>);
+    test::on_string_generators(test_lz77aprox_roundtrip<16, 2>, 13);
+    test::on_string_generators(test_lz77aprox_roundtrip<4, 1>, 13);
+    test::on_string_generators(test_lz77aprox_roundtrip<64, 8>, 13);
+}
+
+template<size_t window, size_t threshold>
+void test_lz77aprox_left_roundtrip(const std::string& str) {
+    test::roundtrip_ex<LZ77AproxCompressor<
+        lzss::BufferedLeftCoder<BinaryCoder, BinaryCoder, BinaryCoder>>>(str, "",
+        "window=" + std::to_string(window) + ",threshold=" + std::to_string(threshold));
+}
+
+TEST(lzss, lz77aprox_left_roundtrip) {
+    test::on_string_generators(test_lz77aprox_left_roundtrip<16, 2>, 13);
+    test::on_string_generators(test_lz77aprox_left_roundtrip<64, 8>, 13);
+}
+
+template<size_t window>
+void test_sliding_window_roundtrip(const std::string& str) {
+    test::roundtrip_ex<LZSSSlidingWindowCompressor<
+        lzss::StreamingCoder<BinaryCoder, BinaryCoder, BinaryCoder>>>(str, "",
+        "window=" + std::to_string(window));
+}
+
+TEST(lzss, sliding_window_roundtrip) {
+    test::roundtrip_batch(test_sliding_window_roundtrip<16>);
+    test::on_string_generators(test_sliding_window_roundtrip<16>, 13);
+    test::on_string_generators(test_sliding_window_roundtrip<100>, 13);
+}
+
+TEST(lzss, lz77aprox_factors) {
+    // the second half repeats the first one,
+    // so it is found in the first round
+    auto result = test::compress<LZ77AproxCompressor<lzss::DidacticalCoder>>(
+        "abcdefghabcdefgh", "window=8,threshold=2");
+    ASSERT_EQ("abcdefgh{0, 8}", result.str);
+}
+
+TEST(lzss, lz77aprox_window) {
+    using lz77aprox_t = LZ77AproxCompressor<lzss::DidacticalCoder>;
+    ASSERT_THROW(test::compress<lz77aprox_t>("abcdefgh", "window=12"), std::invalid_argument);
+    ASSERT_THROW(test::compress<lz77aprox_t>("abcdefgh", "window=0"), std::invalid_argument);
+}
+
+// text data structures that do not need a sentinel
+using sentinel_free_ds_t = DSManager<
+    SAIS, PhiFromSA, PhiAlgorithm, LCPFromPLCP, ISAFromSA>;
+
+using lzss_lcp_no_sentinel_t = LZSSLCPCompressor<
+    lzss::StreamingCoder<BinaryCoder, BinaryCoder, BinaryCoder>,
+    sentinel_free_ds_t>;
+
+using lcpcomp_no_sentinel_t = LCPCompressor<
+    lzss::BufferedBidirectionalCoder<BinaryCoder, BinaryCoder, BinaryCoder>,
+    lcpcomp::ArraysComp,
+    sentinel_free_ds_t>;
+
+TEST(lzss, lzss_lcp_no_sentinel) {
+    ASSERT_FALSE(lzss_lcp_no_sentinel_t::meta().has_tag(tags::require_sentinel));
+
+    // the inputs are neither terminated nor escaped
+    test::roundtrip_batch(test::roundtrip<lzss_lcp_no_sentinel_t>);
+    test::on_string_generators(test::roundtrip<lzss_lcp_no_sentinel_t>, 13);
+    test::roundtrip<lzss_lcp_no_sentinel_t>(std::string("ab\0ab\0ab\0\0\0\0", 12));
+}
+
+// roundtrip with a decoding strategy other than the default
+template<typename dec_t>
+void test_lcpcomp_no_sentinel_dec(string_ref str) {
+    auto result = test::compress<lcpcomp_no_sentinel_t>(str);
+
+    std::vector<uint8_t> decoded;
+    {
+        Input in = Input::from_memory(result.bytes);
+        Output out = Output::from_memory(decoded);
+        auto decompressor = Algorithm::instance<LCPDecompressor<
+            lzss::BufferedBidirectionalCoder<BinaryCoder, BinaryCoder, BinaryCoder>,
+            dec_t>>("dec=" + dec_t::meta().decl()->name());
+        decompressor->decompress(in, out);
+    }
+    ASSERT_EQ(std::string(str), std::string(decoded.begin(), decoded.end()));
+}
+
+TEST(lzss, lcpcomp_no_sentinel) {
+    ASSERT_FALSE(lcpcomp_no_sentinel_t::meta().has_tag(tags::require_sentinel));
+
+    test::roundtrip_batch(test::roundtrip<lcpcomp_no_sentinel_t>);
+    test::on_string_generators(test::roundtrip<lcpcomp_no_sentinel_t>, 13);
+    test::roundtrip<lcpcomp_no_sentinel_t>(std::string("ab\0ab\0ab\0\0\0\0", 12));
+
+    test::roundtrip_batch(test_lcpcomp_no_sentinel_dec<lcpcomp::MultimapBuffer>);
+    test::roundtrip_batch(test_lcpcomp_no_sentinel_dec<lcpcomp::DecodeForwardQueueListBuffer>);
+
+    // the batch includes the empty text, which has a length of zero
+    test_lcpcomp_no_sentinel_dec<lcpcomp::PointerJumpIntEM>("");
+}
@@ -0,0 +1,75 @@
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/RadixScatter.hpp>
+
+using namespace tdc;
+
+static std::vector<uint64_t> random_permutation(size_t n, size_t seed) {
+    std::vector<uint64_t> p(n);
+    std::iota(p.begin(), p.end(), 0);
+    std::shuffle(p.begin(), p.end(), std::mt19937_64(seed));
+    return p;
+}
+
+// generator for the inversion of a permutation
+static auto inverse_of(const std::vector<uint64_t>& p) {
+    return [&p](size_t begin, size_t end, auto emit){
+        for(size_t i = begin; i < end; i++) emit(p[i], i);
+    };
+}
+
+static void check_inverse(const std::vector<uint64_t>& p, const DynamicIntVector& out) {
+    ASSERT_EQ(p.size(), out.size());
+    for(size_t i = 0; i < p.size(); i++) {
+        ASSERT_EQ(i, uint64_t(out[p[i]])) << "i=" << i;
+    }
+}
+
+TEST(radix_scatter, direct) {
+    const auto p = random_permutation(1000, 1);
+    DynamicIntVector out(p.size(), 0, bits_for(p.size()));
+    radix_scatter::direct(out, p.size(), inverse_of(p));
+    check_inverse(p, out);
+}
+
+TEST(radix_scatter, blocked) {
+    for(size_t n : {0, 1, 2, 63, 64, 65, 1000, 4096, 10007}) {
+        const auto p = random_permutation(n, n);
+        for(uint8_t bucket_bits : {0, 1, 5, 6, 10, 15}) {
+            for(uint8_t w : {uint8_t(bits_for(n)), uint8_t(32), uint8_t(64)}) {
+                for(bool parallel : {false, true}) {
+                    DynamicIntVector out(n, 0, std::max(w, uint8_t(1)));
+                    radix_scatter::blocked(
+                        out, n, inverse_of(p), bucket_bits, parallel);
+                    check_inverse(p, out);
+                }
+            }
+        }
+    }
+}
+
+TEST(radix_scatter, large) {
+    const size_t n = radix_scatter::MIN_SIZE + 12345;
+    const auto p = random_permutation(n, 42);
+    ASSERT_EQ(radix_scatter::MIN_BUCKET_BITS, radix_scatter::bucket_bits_for(n));
+
+    for(bool parallel : {false, true}) {
+        DynamicIntVector out(n, 0, bits_for(n));
+        radix_scatter::scatter(out, n, inverse_of(p), parallel);
+        check_inverse(p, out);
+    }
+}
+
+TEST(radix_scatter, bucket_bits) {
+    ASSERT_EQ(radix_scatter::MIN_BUCKET_BITS, radix_scatter::bucket_bits_for(0));
+    ASSERT_EQ(radix_scatter::MIN_BUCKET_BITS, radix_scatter::bucket_bits_for(1ULL << 25));
+    ASSERT_EQ(20U, radix_scatter::bucket_bits_for(1ULL << 30));
+    ASSERT_EQ(30U, radix_scatter::bucket_bits_for(1ULL << 40));
+}
@@ -6,6 +6,9 @@
 #include <tudocomp/ds/select_64bit.hpp>
 #include <tudocomp/ds/Rank.hpp>
 #include <tudocomp/ds/Select.hpp>
+#include <tudocomp/ds/RankSelect.hpp>
+
+#include <random>
 
 using namespace tdc;
 
@@ -172,6 +175,20 @@ TEST(rank_select, inverse_property_64bit) {
     }
 }
 
+TEST(select, select1_word) {
+    uint64_t v64 = 0x8101010101010101ULL;
+    for(size_t i = 1; i <= 8; i++) ASSERT_EQ(8 * (i-1), select1_word(v64, i));
+    ASSERT_EQ(63U, select1_word(v64, 9));
+
+    std::mt19937_64 gen(7);
+    for(size_t t = 0; t < 1000; t++) {
+        const uint64_t v = gen();
+        for(size_t k = 1; k <= rank1(v); k++) {
+            ASSERT_EQ(select1(v, k), select1_word(v, k));
+        }
+    }
+}
+
 template<typename F>
 void NK_test(F f) {
     for(size_t n = 7; n <= 16; n++) {
@@ -270,3 +287,79 @@ TEST(rank_select, inverse_property_bv) {
         }
     });
 }
+
+TEST(rank_select, rank_select_bv) {
+    NK_test([](size_t N, size_t K){
+        // 1-bits
+        {
+            BitVector bv(N);
+            for(size_t i = 0; i < N; i += K) bv[i] = 1;
+
+            RankSelect rs(bv);
+
+            ASSERT_EQ(N/K, rs(N-1));
+            for(size_t i = 1; i <= N/K; i++) ASSERT_EQ(i, rs(K*i-1));
+            for(size_t i = 1; i <= N/K; i++) ASSERT_EQ(1U, rs(K*(i-1), K*i-1));
+
+            ASSERT_EQ(N, rs.select1(1+N/K));
+            for(size_t i = 1; i <= N/K; i++) ASSERT_EQ(K*(i-1), rs.select1(i));
+        }
+        // 0-bits
+        {
+            BitVector bv(N, 1);
+            for(size_t i = 0; i < N; i += K) bv[i] = 0;
+
+            RankSelect rs(bv);
+
+            ASSERT_EQ(N/K, rs.rank0(N-1));
+            for(size_t i = 1; i <= N/K; i++) ASSERT_EQ(i, rs.rank0(K*i-1));
+
+            ASSERT_EQ(N, rs.select0(1+N/K));
+            for(size_t i = 1; i <= N/K; i++) ASSERT_EQ(K*(i-1), rs.select0(i));
+        }
+    });
+}
+
+TEST(rank_select, rank_select_random) {
+    std::mt19937_64 gen(42);
+
+    // sizes that are not a multiple of the block size, and densities
+    // for which select has to cross several blocks
+    for(size_t n : { 1, 63, 64, 65, 511, 513, 100000, 1000003 }) {
+        for(size_t density : { 1, 50, 99 }) {
+            BitVector bv(n);
+            for(size_t i = 0; i < n; i++) bv[i] = (gen() % 100) < density;
+
+            Rank rank(bv);
+            RankSelect rs(bv);
+            ASSERT_EQ(n, rs.size());
+
+            size_t ones = 0;
+            for(size_t i = 0; i < n; i++) {
+                ASSERT_EQ(bool(bv[i]), rs[i]);
+                ASSERT_EQ(rank(i), rs.rank1(i));
+
+                if(bv[i]) {
+                    ++ones;
+                    ASSERT_EQ(i, rs.select1(ones));
+                } else {
+                    ASSERT_EQ(i, rs.select0(i + 1 - ones));
+                }
+            }
+            ASSERT_EQ(n, rs.select1(ones + 1));
+            ASSERT_EQ(n, rs.select0(n - ones + 1));
+        }
+    }
+}
+
+TEST(rank_select, rank_select_copy) {
+    // the data structure owns a copy of the bit vector
+    BitVector bv(1000);
+    for(size_t i = 0; i < bv.size(); i += 3) bv[i] = 1;
+
+    RankSelect rs(bv);
+    bv = BitVector();
+
+    ASSERT_EQ(334U, rs(999));
+    ASSERT_EQ(999U, rs.select1(334));
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <tudocomp/compressors/RePairCompressor.hpp>
+#include <tudocomp/coders/BinaryCoder.hpp>
+
+#include "test/util.hpp"
+
+using namespace tdc;
+
+using repair_t = RePairCompressor<BinaryCoder>;
+
+// extracts the given range from the compressed text
+std::string extract(const test::CompressResult<repair_t>& result,
+                    size_t offset, size_t length) {
+    std::vector<uint8_t> buffer;
+    {
+        Input in = Input::from_memory(result.bytes);
+        Output out = Output::from_memory(buffer);
+
+        auto decompressor =
+            RegistryOf<Compressor>().select<repair_t>("")->decompressor();
+        decompressor->extract(in, out, offset, length);
+    }
+    return std::string(buffer.begin(), buffer.end());
+}
+
+void check_extract(const std::string& text) {
+    auto result = test::compress<repair_t>(text);
+    result.assert_decompress();
+
+    const size_t n = text.size();
+    const size_t step = std::max<size_t>(1, n / 7);
+
+    std::vector<size_t> offsets { 0, 1, n / 2 };
+    for(size_t offset = 0; offset <= n + 1; offset += step) {
+        offsets.push_back(offset);
+    }
+    if(n > 0) offsets.push_back(n - 1);
+    offsets.push_back(n);
+    offsets.push_back(n + 10);
+
+    for(size_t offset : offsets) {
+        for(size_t length : { size_t(0), size_t(1), size_t(5), step, n, SIZE_MAX }) {
+            const std::string expected =
+                (offset < n) ? text.substr(offset, length) : "";
+            ASSERT_EQ(extract(result, offset, length), expected)
+                << "offset " << offset << ", length " << length;
+        }
+    }
+}
+
+TEST(RePair, extract) {
+    check_extract("");
+    check_extract("a");
+    check_extract("abracadabra");
+    check_extract("abcabcabcabcabcabcabcabcabcabc");
+
+    test::on_string_generators([](const std::string& s) {
+        check_extract(s);
+    }, 12);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <tudocomp/util/sais.hpp>
+
+using namespace tdc;
+
+// naive, but certainly correct suffix array construction
+template<typename text_t>
+std::vector<size_t> naive_sa(const text_t& t, size_t n) {
+    std::vector<size_t> sa(n);
+    std::iota(sa.begin(), sa.end(), 0);
+    std::sort(sa.begin(), sa.end(), [&](size_t a, size_t b){
+        while(a < n && b < n) {
+            if(uint64_t(t[a]) != uint64_t(t[b])) return uint64_t(t[a]) < uint64_t(t[b]);
+            ++a; ++b;
+        }
+        return a == n; // the shorter suffix is smaller
+    });
+    return sa;
+}
+
+void check_sais(const DynamicIntVector& t) {
+    const auto expected = naive_sa(t, t.size());
+    const auto sa = sais(t);
+
+    ASSERT_EQ(sa.size(), t.size());
+    ASSERT_LE(sa.width(), bits_for(t.size()));
+    for(size_t i = 0; i < t.size(); ++i) {
+        ASSERT_EQ(uint64_t(sa[i]), expected[i]) << "i=" << i;
+    }
+}
+
+DynamicIntVector random_text(size_t n, uint64_t sigma, size_t seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<uint64_t> dist(0, sigma - 1);
+
+    DynamicIntVector t(n, 0, bits_for(sigma - 1));
+    for(size_t i = 0; i < n; ++i) t[i] = dist(gen);
+    return t;
+}
+
+TEST(sais, empty) {
+    check_sais(DynamicIntVector());
+}
+
+TEST(sais, small) {
+    for(auto& s : std::vector<std::vector<uint64_t>> {
+        {0}, {5}, {1, 0}, {0, 1}, {3, 3, 3, 3, 3},
+        {2, 1, 2, 1, 2, 1, 2}, {1, 0, 2, 2, 0, 2, 2, 0, 1},
+        {1000000, 7, 1000000, 7, 999999, 0, 7}}) {
+
+        DynamicIntVector t(s.size(), 0, 20);
+        for(size_t i = 0; i < s.size(); ++i) t[i] = s[i];
+        check_sais(t);
+    }
+}
+
+TEST(sais, bytes) {
+    const std::string s = "abracadabra";
+
+    std::vector<len_t> sa(s.size());
+    sais((const uint8_t*)s.data(), sa, s.size(), 256);
+
+    const auto expected = naive_sa((const uint8_t*)s.data(), s.size());
+    for(size_t i = 0; i < s.size(); ++i) ASSERT_EQ(sa[i], expected[i]);
+}
+
+TEST(sais, random) {
+    for(uint64_t sigma : {2, 3, 16, 1000, 1000000}) {
+        for(size_t n : {10, 100, 1000, 10000}) {
+            check_sais(random_text(n, sigma, n * sigma));
+        }
+    }
+}
+
+TEST(sais, repetitive) {
+    // periodic texts recurse deeply
+    for(size_t period : {1, 2, 3, 7, 64}) {
+        const auto base = random_text(period, 5, period);
+        DynamicIntVector t(5000, 0, base.width());
+        for(size_t i = 0; i < t.size(); ++i) t[i] = uint64_t(base[i % period]);
+        check_sais(t);
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <sdsl/cst_sada.hpp>
 #include <tudocomp/compressors/lz78u/SuffixTree.hpp>
+#include <tudocomp/compressors/lz78u/LCPSuffixTree.hpp>
 #include "test/util.hpp"
 
 using namespace tdc;
@@ -24,3 +25,40 @@ TEST(SuffixTree, strdepth)     {
     //this never terminates. see bug #18662
 	//test::on_string_generators(test_strdepth,11);
 }
+
+void test_lcp_suffix_tree(const std::string& str) {
+	if(str.length() == 0) return;
+	sdsl::cst_sada<> cst;
+	sdsl::construct_im(cst, str, 1);
+	SuffixTree st(cst);
+
+	const size_t n = cst.csa.size();
+	std::vector<len_t> sa(n), lcp(n);
+	for(size_t i = 0; i < n; ++i) {
+		sa[i] = cst.csa[i];
+		lcp[i] = cst.lcp[i];
+	}
+	LCPSuffixTree lst(sa, lcp);
+	ASSERT_EQ(st.internal_nodes, lst.internal_nodes);
+
+	// the paths from the root to each leaf have to agree
+	for(size_t i = 0; i < n; ++i) {
+		auto leaf = st.select_leaf(i);
+		auto lleaf = lst.select_leaf(i);
+		auto node = st.root;
+		auto lnode = lst.root;
+		while(!st.is_leaf(node)) {
+			ASSERT_FALSE(lst.is_leaf(lnode));
+			ASSERT_EQ(st.str_depth(node), lst.str_depth(lnode));
+			node = st.child_towards(node, leaf);
+			lnode = lst.child_towards(lnode, lleaf);
+			ASSERT_EQ(st.str_depth(st.parent(node)), lst.str_depth(lst.parent(lnode)));
+		}
+		ASSERT_EQ(lleaf, lnode);
+	}
+}
+
+TEST(LCPSuffixTree, paths) {
+	test::roundtrip_batch(test_lcp_suffix_tree, InputRestrictions::escape({0}));
+	test::on_string_generators(test_lcp_suffix_tree, 11);
+}
@@ -47,3 +47,135 @@ TEST(TudocompDriver, algorithm_header) {
     ASSERT_TRUE(text1.find(expected_magic) == 0);
 
 }
+
+TEST(TudocompDriver, batch) {
+    const std::vector<std::string> texts {
+        "abcabcabcabc", "", "asdfghjklöä", "banana$",
+    };
+
+    std::stringstream in_list, comp_list;
+    for(size_t i = 0; i < texts.size(); i++) {
+        auto name = "batch_test_" + std::to_string(i) + ".txt";
+        test::write_test_file(name, texts[i]);
+        test::remove_test_file(name + ".tdc");
+
+        in_list << test::test_file_path(name) << "\n";
+        comp_list << test::test_file_path(name + ".tdc") << "\n";
+    }
+    test::write_test_file("batch_test_in.list", in_list.str());
+    test::write_test_file("batch_test_comp.list", comp_list.str());
+
+    auto comp_out = driver_test::driver("-a 'lz78(ascii)' -j 2 --batch=" +
+        test::test_file_path("batch_test_in.list"));
+    ASSERT_EQ(comp_out, "");
+
+    for(size_t i = 0; i < texts.size(); i++) {
+        auto name = "batch_test_" + std::to_string(i) + ".txt";
+        ASSERT_TRUE(test::test_file_exists(name + ".tdc"));
+        test::remove_test_file(name);
+    }
+
+    auto decomp_out = driver_test::driver("-d -j 2 --batch=" +
+        test::test_file_path("batch_test_comp.list"));
+    ASSERT_EQ(decomp_out, "");
+
+    for(size_t i = 0; i < texts.size(); i++) {
+        auto name = "batch_test_" + std::to_string(i) + ".txt";
+        ASSERT_EQ(test::read_test_file(name), texts[i]);
+    }
+}
+
+TEST(TudocompDriver, extract) {
+    const std::string text = "abcabcabcabcbananabanana";
+    test::write_test_file("extract_test.txt", text);
+
+    // repair extracts from its grammar, lz78 decompresses everything
+    for(std::string algo : { "repair", "lz78(ascii)" }) {
+        test::remove_test_file("extract_test.tdc");
+        auto comp_out = driver_test::driver("-a '" + algo + "' -f -o " +
+            test::test_file_path("extract_test.tdc") + " " +
+            test::test_file_path("extract_test.txt"));
+        ASSERT_EQ(comp_out, "") << algo;
+
+        const std::vector<std::pair<size_t, size_t>> ranges {
+            {0, 0}, {0, 1}, {0, 3}, {5, 7}, {0, text.size()},
+            {20, 100}, {text.size() - 1, 1}, {text.size(), 5}, {30, 2},
+        };
+        for(auto& r : ranges) {
+            test::remove_test_file("extract_test.out");
+            auto out = driver_test::driver("--extract=" +
+                std::to_string(r.first) + "," + std::to_string(r.second) +
+                " -f -o " + test::test_file_path("extract_test.out") + " " +
+                test::test_file_path("extract_test.tdc"));
+            ASSERT_EQ(out, "") << algo;
+
+            const std::string expected =
+                (r.first < text.size()) ? text.substr(r.first, r.second) : "";
+            ASSERT_EQ(test::read_test_file("extract_test.out"), expected)
+                << algo << ": offset " << r.first << ", length " << r.second;
+        }
+    }
+}
+
+TEST(TudocompDriver, bench) {
+    test::write_test_file("bench_test.txt", "abcabcabcabcbananabanana");
+
+    auto out = driver_test::driver("-a 'lz78(ascii)' --bench=2 " +
+        test::test_file_path("bench_test.txt"));
+
+    ASSERT_EQ(out.find("Error"), std::string::npos) << out;
+    ASSERT_NE(out.find("\"throughput_mib_s\""), std::string::npos) << out;
+    ASSERT_NE(out.find("\"p99\""), std::string::npos) << out;
+}
+
+TEST(TudocompDriver, perf) {
+    test::write_test_file("perf_test.txt", "abcabcabcabcbananabanana");
+
+    // the counters may not be permitted on the test machine,
+    // but the statistics must be written either way
+    auto out = driver_test::driver("-a 'lz78(ascii)' --perf --stats -f " +
+        test::test_file_path("perf_test.txt") + " -o " +
+        test::test_file_path("perf_test.tdc"));
+
+    ASSERT_EQ(out.find("Error"), std::string::npos) << out;
+    ASSERT_NE(out.find("\"meta\""), std::string::npos) << out;
+
+    // either the phases contain counter values, or the driver
+    // reported why it could not record them
+    const bool has_counters = (out.find("\"perf_") != std::string::npos);
+    const bool unavailable =
+        (out.find("performance counters are") != std::string::npos);
+    ASSERT_TRUE(has_counters || unavailable) << out;
+}
+
+TEST(TudocompDriver, trace) {
+    test::write_test_file("trace_test.txt", "abcabcabcabcbananabanana");
+
+    auto out = driver_test::driver("-a 'lz78(ascii)' -f " +
+        test::test_file_path("trace_test.txt") + " -o " +
+        test::test_file_path("trace_test.tdc") + " --trace=" +
+        test::test_file_path("trace_test.json"));
+
+    ASSERT_EQ(out.find("Error"), std::string::npos) << out;
+
+    auto trace = test::read_test_file("trace_test.json");
+    ASSERT_NE(trace.find("\"traceEvents\""), std::string::npos) << trace;
+    ASSERT_NE(trace.find("\"root\""), std::string::npos) << trace;
+}
+
+TEST(TudocompDriver, sais_zero_bytes) {
+    // with SA-IS, the text data structures need no sentinel,
+    // so 0 bytes are passed through without escaping
+    const std::string text("ab\0ab\0\0abab\0ba\0\0\0ab\0ab\0", 24);
+    const std::string ds =
+        "ds=ds(providers=[sais(),phi(),phi_algorithm(),lcp(),isa()])";
+
+    bool abort = false;
+    for(std::string algo : {
+        "lcpcomp(coder=bi(binary,binary,binary),threshold=2," + ds + ")",
+        "lzss_lcp(coder=bi(binary,binary,binary)," + ds + ")",
+    }) {
+        driver_test::roundtrip(algo, "_zero_bytes", text, false, abort, false).check();
+        ASSERT_FALSE(abort);
+    }
+}